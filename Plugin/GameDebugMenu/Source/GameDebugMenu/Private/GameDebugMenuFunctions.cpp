@@ -11,16 +11,46 @@
 #include "Kismet/GameplayStatics.h"
 #include "CoreGlobals.h"
 #include "Misc/ConfigCacheIni.h"
+#include "Engine/AssetManager.h"
+#include "Engine/StreamableManager.h"
 #include <GeneralProjectSettings.h>
 
 #include "GameDebugMenuSettings.h"
 #include "Component/GDMLocalizeStringComponent.h"
 #include "Data/GameDebugMenuMasterAsset.h"
 #include "Input/GDMInputSystemComponent.h"
+#include "Log/GDMOutputDeviceBenchmark.h"
 
 TArray< TWeakObjectPtr<AGameDebugMenuManager> > GGameDebugMenuManagers;
-TArray<FGDMPendingObjectData> UGameDebugMenuFunctions::RegisterPendingProperties;
-TArray<FGDMPendingObjectData> UGameDebugMenuFunctions::RegisterPendingFunctions;
+
+namespace
+{
+	/** ワールドごとに登録されたManager。GetGameDebugMenuManager等で全件走査せずに引くための索引 */
+	struct FGDMWorldManagers
+	{
+		/** 登録順 */
+		TArray< TWeakObjectPtr<AGameDebugMenuManager> > Managers;
+
+		/** Owner(PlayerController) -> Manager */
+		TMap< TWeakObjectPtr<const APlayerController>, TWeakObjectPtr<AGameDebugMenuManager> > PlayerManagers;
+	};
+
+	TMap< TWeakObjectPtr<const UWorld>, FGDMWorldManagers > GGameDebugMenuManagersByWorld;
+
+	/* 破棄済みワールドの項目を取り除く（PIEの終了等） */
+	void RemoveStaleWorldManagers()
+	{
+		for (auto It = GGameDebugMenuManagersByWorld.CreateIterator(); It; ++It)
+		{
+			if (!It.Key().IsValid())
+			{
+				It.RemoveCurrent();
+			}
+		}
+	}
+}
+
+TMap<TWeakObjectPtr<const UWorld>, FGDMPendingObjectQueue> UGameDebugMenuFunctions::PendingObjectQueues;
 FDelegateHandle UGameDebugMenuFunctions::ActorSpawnedDelegateHandle;
 bool UGameDebugMenuFunctions::bDisableGameDebugMenu = false;
 
@@ -51,6 +81,14 @@ UGameDebugMenuFunctions::UGameDebugMenuFunctions(const FObjectInitializer& Objec
 		{
 			ConsoleManager.RegisterConsoleCommand(*ToggleInputCommand, TEXT("Toggle Game Debug Menu InputSystem Log"), FConsoleCommandDelegate::CreateStatic(UGameDebugMenuFunctions::ToggleInputSystemLog), ECVF_Default);
 		}
+
+#if !(UE_BUILD_SHIPPING)
+		const FString BenchmarkOutputDeviceCommand = TEXT("GDM.BenchmarkOutputDevice");
+		if( ConsoleManager.FindConsoleObject(*BenchmarkOutputDeviceCommand) == nullptr )
+		{
+			ConsoleManager.RegisterConsoleCommand(*BenchmarkOutputDeviceCommand, TEXT("Measure Game Debug Menu log capture cost. Args: [NumThreads] [NumLinesPerThread]"), FConsoleCommandWithArgsDelegate::CreateStatic(FGDMOutputDeviceBenchmark::RunConsoleCommand), ECVF_Default);
+		}
+#endif
 	}
 }
 
@@ -58,6 +96,18 @@ void UGameDebugMenuFunctions::RegisterGameDebugMenuManagerInstance(AGameDebugMen
 {
 	GGameDebugMenuManagers.AddUnique(RegisterManager);
 
+	RemoveStaleWorldManagers();
+	if (const UWorld* World = RegisterManager->GetWorld())
+	{
+		FGDMWorldManagers& WorldManagers = GGameDebugMenuManagersByWorld.FindOrAdd(World);
+		WorldManagers.Managers.AddUnique(RegisterManager);
+
+		if (const APlayerController* PlayerController = Cast<APlayerController>(RegisterManager->GetOwner()))
+		{
+			WorldManagers.PlayerManagers.Add(PlayerController, RegisterManager);
+		}
+	}
+
 	if( !UKismetSystemLibrary::IsServer(RegisterManager) )
 	{
 		/* Client */
@@ -68,9 +118,77 @@ void UGameDebugMenuFunctions::RegisterGameDebugMenuManagerInstance(AGameDebugMen
 void UGameDebugMenuFunctions::UnregisterGameDebugMenuManagerInstance(AGameDebugMenuManager* UnregisterManager)
 {
 	GGameDebugMenuManagers.Remove(UnregisterManager);
+
+	/* EndPlay時点ではワールドが取れるのでそのワールドの項目から外す */
+	if (FGDMWorldManagers* WorldManagers = GGameDebugMenuManagersByWorld.Find(UnregisterManager->GetWorld()))
+	{
+		WorldManagers->Managers.Remove(UnregisterManager);
+
+		for (auto It = WorldManagers->PlayerManagers.CreateIterator(); It; ++It)
+		{
+			if (!It.Value().IsValid() || It.Value().Get() == UnregisterManager)
+			{
+				It.RemoveCurrent();
+			}
+		}
+
+		if (WorldManagers->Managers.IsEmpty())
+		{
+			GGameDebugMenuManagersByWorld.Remove(UnregisterManager->GetWorld());
+		}
+	}
+	RemoveStaleWorldManagers();
 }
 
 bool UGameDebugMenuFunctions::TryCreateDebugMenuManager(APlayerController* PlayerController, FString DebugMenuManagerClassName)
+{
+	TSoftClassPtr<AGameDebugMenuManager> ManagerClass;
+	if (!FindDebugMenuManagerClass(PlayerController, DebugMenuManagerClassName, ManagerClass))
+	{
+		return false;
+	}
+
+	return CreateDebugMenuManager(PlayerController, DebugMenuManagerClassName, ManagerClass.LoadSynchronous());
+}
+
+void UGameDebugMenuFunctions::TryCreateDebugMenuManagerAsync(APlayerController* PlayerController, FString DebugMenuManagerClassName, FGDMOnCreatedDebugMenuManager OnCompleted)
+{
+	TSoftClassPtr<AGameDebugMenuManager> ManagerClass;
+	if (!FindDebugMenuManagerClass(PlayerController, DebugMenuManagerClassName, ManagerClass))
+	{
+		OnCompleted.ExecuteIfBound(false);
+		return;
+	}
+
+	if (ManagerClass.IsNull() || ManagerClass.IsValid())
+	{
+		/* ロード済み（またはクラスが見つからない）ならそのまま生成処理へ */
+		OnCompleted.ExecuteIfBound(CreateDebugMenuManager(PlayerController, DebugMenuManagerClassName, ManagerClass.Get()));
+		return;
+	}
+
+	UE_LOG(LogGDM, Log, TEXT("TryCreateDebugMenuManagerAsync: Start load %s"), *ManagerClass.ToString());
+
+	TWeakObjectPtr<APlayerController> WeakPlayerController = PlayerController;
+	UAssetManager::GetStreamableManager().RequestAsyncLoad(
+		ManagerClass.ToSoftObjectPath(),
+		FStreamableDelegate::CreateLambda([WeakPlayerController, DebugMenuManagerClassName, ManagerClass, OnCompleted]()
+		{
+			APlayerController* LoadedPlayerController = WeakPlayerController.Get();
+			if (!IsValid(LoadedPlayerController))
+			{
+				/* ロード中にPlayerController（ワールド）が破棄された */
+				UE_LOG(LogGDM, Log, TEXT("TryCreateDebugMenuManagerAsync: PlayerController destroyed while loading %s"), *DebugMenuManagerClassName);
+				OnCompleted.ExecuteIfBound(false);
+				return;
+			}
+
+			OnCompleted.ExecuteIfBound(CreateDebugMenuManager(LoadedPlayerController, DebugMenuManagerClassName, ManagerClass.Get()));
+		}),
+		FStreamableManager::AsyncLoadHighPriority);
+}
+
+bool UGameDebugMenuFunctions::FindDebugMenuManagerClass(APlayerController* PlayerController, const FString& DebugMenuManagerClassName, TSoftClassPtr<AGameDebugMenuManager>& OutManagerClass)
 {
 	bool bServer    = UKismetSystemLibrary::IsServer(PlayerController);
 	FString NetMode = (bServer ? TEXT("Server") : TEXT("Client"));
@@ -95,13 +213,32 @@ bool UGameDebugMenuFunctions::TryCreateDebugMenuManager(APlayerController* Playe
 
 		/* 生成ができない環境なので無効フラグを立てる */
 		bDisableGameDebugMenu = true;
-		RegisterPendingProperties.Empty();
-		RegisterPendingFunctions.Empty();
+		PendingObjectQueues.Empty();
 		return false;
 	}
 	
-	const auto ManagerClass = MasterAsset->GetGameDebugMenuManagerSoftClass(DebugMenuManagerClassName);
-	UClass* DebugMenuManagerClass = ManagerClass.LoadSynchronous();
+	OutManagerClass = MasterAsset->GetGameDebugMenuManagerSoftClass(DebugMenuManagerClassName);
+	if (OutManagerClass.IsNull())
+	{
+		UE_LOG(LogGDM, Warning, TEXT("TryCreateDebugMenuManager: Not found class name [%s] %s"), *NetMode, *DebugMenuManagerClassName);
+	}
+	
+	/* クラスが見つからない場合も生成処理側でエラー扱いにする */
+	return true;
+}
+
+bool UGameDebugMenuFunctions::CreateDebugMenuManager(APlayerController* PlayerController, const FString& DebugMenuManagerClassName, UClass* DebugMenuManagerClass)
+{
+	bool bServer    = UKismetSystemLibrary::IsServer(PlayerController);
+	FString NetMode = (bServer ? TEXT("Server") : TEXT("Client"));
+
+	UWorld* World = GEngine->GetWorldFromContextObject(PlayerController, EGetWorldErrorMode::LogAndReturnNull);
+	if(World == nullptr)
+	{
+		UE_LOG(LogGDM, Warning, TEXT("TryCreateDebugMenuManager: Not found world[%s]"), *NetMode);
+		return false;
+	}
+
 	if(DebugMenuManagerClass == nullptr)
 	{
 		FString ErrorStr = TEXT("DebugMenuManagerClass NotFound LoadError");
@@ -114,8 +251,7 @@ bool UGameDebugMenuFunctions::TryCreateDebugMenuManager(APlayerController* Playe
 
 		/* 生成ができない環境なので無効フラグを立てる */
 		bDisableGameDebugMenu = true;
-		RegisterPendingProperties.Empty();
-		RegisterPendingFunctions.Empty();
+		PendingObjectQueues.Empty();
 		return false;
 	}
 
@@ -161,64 +297,8 @@ bool UGameDebugMenuFunctions::TryCreateDebugMenuManager(APlayerController* Playe
 		ActorSpawnedDelegateHandle = World->AddOnActorSpawnedHandler(FOnActorSpawned::FDelegate::CreateStatic(&UGameDebugMenuFunctions::OnActorSpawnedServer));
 	}
 
-	/* マネージャー生成前に登録処理したプロパティ群を追加する */
-	for(int32 Index = 0; Index < RegisterPendingProperties.Num(); ++Index)
-	{
-		if(RegisterPendingProperties.IsValidIndex(Index))
-		{
-			const auto& PendingData = RegisterPendingProperties[Index];
-			if(PendingData.TargetObject.IsValid())
-			{
-				RegisterGDMObjectProperty(PendingData.TargetObject.Get()
-					,PendingData.ConfigInfo
-					,PendingData.TargetName
-					,PendingData.CategoryKey
-					,PendingData.SaveKey
-					,PendingData.DisplayPropertyName
-					,PendingData.Description
-					,PendingData.DisplayPriority
-				);
-			}
-		}
-	}
-
-	/* マネージャー生成前に登録処理した関数群を追加する */
-	for(int32 Index = 0; Index < RegisterPendingFunctions.Num(); ++Index)
-	{
-		if(RegisterPendingFunctions.IsValidIndex(Index))
-		{
-			const auto& PendingData = RegisterPendingFunctions[Index];
-			if(PendingData.TargetObject.IsValid())
-			{
-				RegisterGDMObjectFunction(PendingData.TargetObject.Get(),
-										  PendingData.TargetName,
-										  PendingData.CategoryKey,
-										  PendingData.SaveKey,
-										  PendingData.DisplayPropertyName,
-										  PendingData.Description,
-										  PendingData.DisplayPriority
-				);
-			}
-		}
-	}
-
-	RegisterPendingProperties.RemoveAll([&](const FGDMPendingObjectData& PropertyData)
-	{
-		if(!PropertyData.TargetObject.IsValid())
-		{
-			return true;
-		}
-		return (PropertyData.TargetObject->GetWorld() == World );
-	});
-
-	RegisterPendingFunctions.RemoveAll([&](const FGDMPendingObjectData& FunctionData)
-	{
-		if(!FunctionData.TargetObject.IsValid())
-		{
-			return true;
-		}
-		return (FunctionData.TargetObject->GetWorld() == World );
-	});
+	/* マネージャー生成前に登録処理したプロパティ群、関数群をまとめて追加する（ローカルのマネージャーが無いワールドなら破棄） */
+	FlushPendingObjectQueue(World, GetGameDebugMenuManager(PlayerController, false));
 
 	UE_LOG(LogGDM, Log, TEXT("TryCreateDebugMenuManager: Success %s"), *NetMode);
 
@@ -231,23 +311,7 @@ bool UGameDebugMenuFunctions::DestroyDebugMenuManager(APlayerController* PlayerC
 	if(World != nullptr)
 	{
 		World->RemoveOnActorSpawnedHandler(ActorSpawnedDelegateHandle);
-		RegisterPendingProperties.RemoveAll([&](const FGDMPendingObjectData& PropertyData)
-			{
-				if (!PropertyData.TargetObject.IsValid())
-				{
-					return true;
-				}
-				return (PropertyData.TargetObject->GetWorld() == World);
-			});
-
-		RegisterPendingFunctions.RemoveAll([&](const FGDMPendingObjectData& FunctionData)
-			{
-				if (!FunctionData.TargetObject.IsValid())
-				{
-					return true;
-				}
-				return (FunctionData.TargetObject->GetWorld() == World);
-			});
+		PendingObjectQueues.Remove(World);
 	}
 
 	AGameDebugMenuManager* GDMManager = GetGameDebugMenuManager(PlayerController, false);
@@ -277,13 +341,13 @@ AGameDebugMenuManager* UGameDebugMenuFunctions::GetGameDebugMenuManager(const UO
 
 	AGameDebugMenuManager* GDMManager = nullptr;
 
-	for (const auto Manager : GGameDebugMenuManagers )
+	if (const FGDMWorldManagers* WorldManagers = GGameDebugMenuManagersByWorld.Find(World))
 	{
-		if (Manager->GetWorld() == World)
+		for (const auto& Manager : WorldManagers->Managers)
 		{
-			if (IsValid(Manager->GetOwner()))
+			if (Manager.IsValid() && IsValid(Manager->GetOwner()))
 			{
-				GDMManager = Cast<AGameDebugMenuManager>(Manager);
+				GDMManager = Manager.Get();
 				break;
 			}
 		}
@@ -304,15 +368,24 @@ AGameDebugMenuManager* UGameDebugMenuFunctions::GetGameDebugMenuManager(const UO
 
 AGameDebugMenuManager* UGameDebugMenuFunctions::TryGetGameDebugMenuManagerFromPlayerController(const APlayerController* PlayerController)
 {
-	for (const auto Manager : GGameDebugMenuManagers )
+	if (!IsValid(PlayerController))
 	{
-		if (Manager->GetOwner() == PlayerController)
-		{
-			return Cast<AGameDebugMenuManager>(Manager);
-		}
+		return nullptr;
 	}
 
-	return nullptr;
+	const FGDMWorldManagers* WorldManagers = GGameDebugMenuManagersByWorld.Find(PlayerController->GetWorld());
+	if (WorldManagers == nullptr)
+	{
+		return nullptr;
+	}
+
+	const TWeakObjectPtr<AGameDebugMenuManager>* Manager = WorldManagers->PlayerManagers.Find(PlayerController);
+	if (Manager == nullptr || !Manager->IsValid() || (*Manager)->GetOwner() != PlayerController)
+	{
+		return nullptr;
+	}
+
+	return Manager->Get();
 }
 
 bool UGameDebugMenuFunctions::ShowDebugMenu(UObject* WorldContextObject)
@@ -398,9 +471,16 @@ bool UGameDebugMenuFunctions::RegisterGDMObjectProperty(UObject* TargetObject, c
 		return false;
 	}
 
-	AGameDebugMenuManager* GDMManager = GetGameDebugMenuManager(TargetObject);
+	/* 初期化完了前でもローカルのマネージャーがあれば保存データは読み込み済みなので直接登録する */
+	AGameDebugMenuManager* GDMManager = GetGameDebugMenuManager(TargetObject, false);
 	if(!IsValid(GDMManager))
 	{
+		FGDMPendingObjectQueue* PendingQueue = FindOrAddPendingObjectQueue(TargetObject);
+		if (PendingQueue == nullptr)
+		{
+			return false;
+		}
+
 		/* まだ生成してないので一時キャッシュ */
 		FGDMPendingObjectData PendingData;
 		PendingData.TargetObject        = TargetObject;
@@ -411,7 +491,7 @@ bool UGameDebugMenuFunctions::RegisterGDMObjectProperty(UObject* TargetObject, c
 		PendingData.Description         = Description;
 		PendingData.ConfigInfo          = PropertyUIConfigInfo;
 		PendingData.DisplayPriority		= DisplayPriority;
-		RegisterPendingProperties.Add(PendingData);
+		PendingQueue->Properties.Add(PendingData);
 		return false;
 	}
 	
@@ -426,9 +506,16 @@ bool UGameDebugMenuFunctions::RegisterGDMObjectFunction(UObject* TargetObject, F
 		return false;
 	}
 
-	AGameDebugMenuManager* GDMManager = GetGameDebugMenuManager(TargetObject);
+	/* 初期化完了前でもローカルのマネージャーがあれば保存データは読み込み済みなので直接登録する */
+	AGameDebugMenuManager* GDMManager = GetGameDebugMenuManager(TargetObject, false);
 	if(!IsValid(GDMManager))
 	{
+		FGDMPendingObjectQueue* PendingQueue = FindOrAddPendingObjectQueue(TargetObject);
+		if (PendingQueue == nullptr)
+		{
+			return false;
+		}
+
 		/* まだ生成してないので一時キャッシュ */
 		FGDMPendingObjectData PendingData;
 		PendingData.TargetObject        = TargetObject;
@@ -438,7 +525,7 @@ bool UGameDebugMenuFunctions::RegisterGDMObjectFunction(UObject* TargetObject, F
 		PendingData.DisplayPropertyName = DisplayFunctionName;
 		PendingData.Description         = Description;
 		PendingData.DisplayPriority		= DisplayPriority;
-		RegisterPendingFunctions.Add(PendingData);
+		PendingQueue->Functions.Add(PendingData);
 		return false;
 	}
 	
@@ -828,64 +915,45 @@ FGDMMenuCategoryKey UGameDebugMenuFunctions::Conv_ByteToGDMMenuCategoryKey(const
 
 void UGameDebugMenuFunctions::OnActorSpawnedClientWaitManager(AGameDebugMenuManager* SpawnDebugMenuManager)
 {	
-	/* マネージャー生成前に登録処理したプロパティ群を追加する */
-	for(const auto& PendingData : RegisterPendingProperties)
+	/* マネージャー生成前に登録処理したプロパティ群、関数群をまとめて追加する */
+	FlushPendingObjectQueue(SpawnDebugMenuManager->GetWorld(), SpawnDebugMenuManager);
+
+	UE_LOG(LogGDM, Log, TEXT("OnActorSpawnedClientWaitManager: Spawn GameDebugMenuManager"));
+}
+
+FGDMPendingObjectQueue* UGameDebugMenuFunctions::FindOrAddPendingObjectQueue(const UObject* TargetObject)
+{
+	const UWorld* World = IsValid(TargetObject) ? TargetObject->GetWorld() : nullptr;
+	if (World == nullptr)
 	{
-		if(PendingData.TargetObject.IsValid())
-		{
-			if( PendingData.TargetObject->GetWorld() == SpawnDebugMenuManager->GetWorld() )
-			{
-				RegisterGDMObjectProperty(PendingData.TargetObject.Get()
-					,PendingData.ConfigInfo
-					,PendingData.TargetName
-					,PendingData.CategoryKey
-					,PendingData.SaveKey
-					,PendingData.DisplayPropertyName
-					,PendingData.Description
-					,PendingData.DisplayPriority
-				);
-			}
-		}
+		UE_LOG(LogGDM, Warning, TEXT("FindOrAddPendingObjectQueue: Not found World %s"), *GetNameSafe(TargetObject));
+		return nullptr;
 	}
 
-	/* マネージャー生成前に登録処理した関数群を追加する */
-	for(const auto& PendingData : RegisterPendingFunctions)
+	/* 終了したワールド（PIE等）の分を破棄 */
+	for (auto It = PendingObjectQueues.CreateIterator(); It; ++It)
 	{
-		if(PendingData.TargetObject.IsValid())
+		if (!It.Key().IsValid())
 		{
-			if( PendingData.TargetObject->GetWorld() == SpawnDebugMenuManager->GetWorld() )
-			{
-				RegisterGDMObjectFunction(PendingData.TargetObject.Get()
-					,PendingData.TargetName
-					,PendingData.CategoryKey
-					,PendingData.SaveKey
-					,PendingData.DisplayPropertyName
-					,PendingData.Description
-					,PendingData.DisplayPriority
-				);
-			}
+			It.RemoveCurrent();
 		}
 	}
 
-	RegisterPendingProperties.RemoveAll([&](const FGDMPendingObjectData& PropertyData)
-		{
-			if (!PropertyData.TargetObject.IsValid())
-			{
-				return true;
-			}
-			return (PropertyData.TargetObject->GetWorld() == SpawnDebugMenuManager->GetWorld());
-		});
+	return &PendingObjectQueues.FindOrAdd(World);
+}
 
-	RegisterPendingFunctions.RemoveAll([&](const FGDMPendingObjectData& FunctionData)
-		{
-			if (!FunctionData.TargetObject.IsValid())
-			{
-				return true;
-			}
-			return (FunctionData.TargetObject->GetWorld() == SpawnDebugMenuManager->GetWorld());
-		});
+void UGameDebugMenuFunctions::FlushPendingObjectQueue(const UWorld* World, AGameDebugMenuManager* DebugMenuManager)
+{
+	FGDMPendingObjectQueue PendingQueue;
+	if (!PendingObjectQueues.RemoveAndCopyValue(World, PendingQueue))
+	{
+		return;
+	}
 
-	UE_LOG(LogGDM, Log, TEXT("OnActorSpawnedClientWaitManager: Spawn GameDebugMenuManager"));
+	if (IsValid(DebugMenuManager))
+	{
+		DebugMenuManager->RegisterPendingObjects(PendingQueue);
+	}
 }
 
 void UGameDebugMenuFunctions::OnActorSpawnedServer(AActor* SpawnActor)
@@ -960,7 +1028,7 @@ void UGameDebugMenuFunctions::ToggleInputSystemLog()
 		if (IsValid(Manager->GetWorld()) && IsValid(Manager->GetOwner()))
 		{
 			UGDMInputSystemComponent* InputSystemComponent = Manager->GetDebugMenuInputSystemComponent();
-			InputSystemComponent->bOutputDebugLog = !InputSystemComponent->bOutputDebugLog;
+			InputSystemComponent->SetOutputDebugLog(!InputSystemComponent->bOutputDebugLog);
 			break;
 		}
 	}
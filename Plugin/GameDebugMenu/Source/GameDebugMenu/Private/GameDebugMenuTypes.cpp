@@ -87,6 +87,17 @@ FString FGDMConsoleCommandNumber::BuildCommandIdentifier() const
 	);
 }
 
+/************************************************************************
+ * FGDMConsoleCommandSearchResult
+ ************************************************************************/
+
+FGDMConsoleCommandSearchResult::FGDMConsoleCommandSearchResult()
+	: Type(EGDMConsoleCommandType::Non)
+	, ArrayIndex(INDEX_NONE)
+	, Score(0.0f)
+{
+}
+
 /************************************************************************
  * FGDMJiraSettings
  ************************************************************************/
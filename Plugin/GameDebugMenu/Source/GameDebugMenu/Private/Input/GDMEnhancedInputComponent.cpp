@@ -24,7 +24,7 @@ UGDMEnhancedInputComponent::UGDMEnhancedInputComponent()
 
 bool UGDMEnhancedInputComponent::CanProcessInputAction(const UInputAction* Action) const
 {
-	AGameDebugMenuManager* Manager = UGameDebugMenuFunctions::GetGameDebugMenuManager(this);
+	const AGameDebugMenuManager* Manager = GetCachedManager();
 	if (!IsValid(Manager))
 	{
 		return false;
@@ -39,18 +39,45 @@ bool UGDMEnhancedInputComponent::CanProcessInputAction(const UInputAction* Actio
 	return true;
 }
 
+AGameDebugMenuManager* UGDMEnhancedInputComponent::GetCachedManager() const
+{
+	AGameDebugMenuManager* Manager = CachedManager.Get();
+	if (IsValid(Manager))
+	{
+		return Manager;
+	}
+
+	/* 未取得か破棄された（初期化前は取得できないので見つかった時だけ保持する） */
+	Manager = UGameDebugMenuFunctions::GetGameDebugMenuManager(this);
+	CachedManager = Manager;
+	return Manager;
+}
+
 FEnhancedInputActionEventBinding& UGDMEnhancedInputComponent::BindDebugMenuAction(const UInputAction* Action, ETriggerEvent TriggerEvent, UObject* Object, FName FunctionName)
 {
+	/* 入力毎に検索しないようにバインド時に解決しておく */
+	GetCachedManager();
+	TWeakObjectPtr<UFunction> CachedFunction = IsValid(Object) ? Object->FindFunction(FunctionName) : nullptr;
+
 	return BindActionInstanceLambda(
 		Action,
 		TriggerEvent,
-		[this, Object, FunctionName, Action](const FInputActionInstance& Instance)
+		[this, WeakObject = TWeakObjectPtr<UObject>(Object), FunctionName, Action, CachedFunction](const FInputActionInstance& Instance) mutable
 		{
-			if (CanProcessInputAction(Action) && IsValid(Object))
+			UObject* TargetObject = WeakObject.Get();
+			if (CanProcessInputAction(Action) && IsValid(TargetObject))
 			{
-				if (UFunction* Func = Object->FindFunction(FunctionName))
+				UFunction* Func = CachedFunction.Get();
+				if (Func == nullptr || !TargetObject->GetClass()->IsChildOf(Func->GetOuterUClass()))
+				{
+					/* BPの再コンパイル等で関数やクラスが作り直された場合は引き直す（古い関数が残っていてもクラスが一致しなければ使わない） */
+					Func = TargetObject->FindFunction(FunctionName);
+					CachedFunction = Func;
+				}
+
+				if (Func != nullptr)
 				{
-					Object->ProcessEvent(Func, nullptr);
+					TargetObject->ProcessEvent(Func, nullptr);
 				}
 			}
 		});
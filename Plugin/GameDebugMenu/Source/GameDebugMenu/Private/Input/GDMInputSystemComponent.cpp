@@ -21,8 +21,10 @@
 UGDMInputSystemComponent::UGDMInputSystemComponent()
 	: IgnoreDebugMenuInput(0)
 	, DebugCameraInput(nullptr)
-	, RegisteredInputGroups()
-	, ActiveInputStacks()
+	, InputEntries()
+	, InputEntryIndices()
+	, InputGroups()
+	, InputGroupIndices()
 	, CurrentInputGroupName(NAME_None)
 	, bMenuOpen(false)
 	, RootWidgetInputComponent(nullptr)
@@ -30,10 +32,15 @@ UGDMInputSystemComponent::UGDMInputSystemComponent()
 	, AddInputMappingContextWhenDebugMenuIsShow()
 	, ActorSpawnedDelegateHandle()
 	, DebugCameraController(nullptr)
+	, CachedDebugLogText()
+	, CachedDebugLogLanguage(NAME_None)
+	, CachedDebugLogInputComponents()
+	, bDebugLogTextDirty(true)
 	, bOutputDebugLog(false)
 {
+	/* 入力判定用ログの表示中だけTickする */
 	PrimaryComponentTick.bCanEverTick = true;
-	PrimaryComponentTick.bStartWithTickEnabled = true;
+	PrimaryComponentTick.bStartWithTickEnabled = false;
 	PrimaryComponentTick.TickGroup = ETickingGroup::TG_PrePhysics;
 	PrimaryComponentTick.bTickEvenWhenPaused = true;
 	bNeverNeedsRenderUpdate = true;
@@ -43,37 +50,32 @@ void UGDMInputSystemComponent::TickComponent(float DeltaTime, enum ELevelTick Ti
 {
 	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
 
-	if (bOutputDebugLog)
+	if (!bOutputDebugLog)
 	{
-		FString DebugText;
-		
-		const AGameDebugMenuManager* Manager = GetOwnerGameDebugMenuManager();
-		FString GroupName;
-		Manager->GetLocalizeStringComponent()->GetString(CurrentInputGroupName.ToString(), GroupName);
-		
-		DebugText += FString::Printf(TEXT("[GameDebugMenu] Input Current Group: %s\n"), *GroupName);
-		
-		if (const TArray<TWeakObjectPtr<UInputComponent>>* Stack = ActiveInputStacks.Find(CurrentInputGroupName))
+		SetComponentTickEnabled(false);
+		return;
+	}
+
+	/* 表示中のInputComponentがGCされた場合は登録解除を経由しないので、ここで検知する */
+	if (!bDebugLogTextDirty)
+	{
+		for (const TWeakObjectPtr<const UInputComponent>& Input : CachedDebugLogInputComponents)
 		{
-			for (const TWeakObjectPtr<UInputComponent>& Comp : *Stack)
+			if (!Input.IsValid())
 			{
-				if (const UInputComponent* Input = Comp.Get())
-				{
-					const UObject* Outer = Input->GetOuter();
-					FString OuterLabel = TEXT("(null)");
-					if (IsValid(Outer))
-					{
-						FString AssetName;
-						Outer->GetFullName(nullptr).Split(TEXT("."), nullptr, &AssetName,  ESearchCase::IgnoreCase, ESearchDir::FromEnd);
-						OuterLabel = AssetName;
-					}
-					DebugText += FString::Printf(TEXT("    > %s\n"), *OuterLabel);
-				}
+				bDebugLogTextDirty = true;
+				break;
 			}
 		}
+	}
 
-		GEngine->AddOnScreenDebugMessage(-1, 0.0f, FColor::Green, DebugText);
+	const AGameDebugMenuManager* Manager = GetOwnerGameDebugMenuManager();
+	if (bDebugLogTextDirty || CachedDebugLogLanguage != Manager->GetLocalizeStringComponent()->GetCurrentDebugMenuLanguage())
+	{
+		RebuildDebugLogText();
 	}
+
+	GEngine->AddOnScreenDebugMessage(-1, 0.0f, FColor::Green, CachedDebugLogText);
 }
 
 void UGDMInputSystemComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
@@ -102,6 +104,13 @@ bool UGDMInputSystemComponent::IsInputIgnored() const
 	return (IgnoreDebugMenuInput > 0);
 }
 
+void UGDMInputSystemComponent::SetOutputDebugLog(bool bNewOutputDebugLog)
+{
+	bOutputDebugLog = bNewOutputDebugLog;
+	bDebugLogTextDirty = true;
+	SetComponentTickEnabled(bOutputDebugLog);
+}
+
 void UGDMInputSystemComponent::Initialize(UGameDebugMenuManagerAsset* MenuDataAsset)
 {
 	AddInputMappingContextWhenCreateManager = MenuDataAsset->AddInputMappingContextWhenCreateManager;
@@ -109,8 +118,7 @@ void UGDMInputSystemComponent::Initialize(UGameDebugMenuManagerAsset* MenuDataAs
 
 	CreateDebugCameraInputClass(MenuDataAsset->DebugCameraInputClass);
 	
-	TArray<APlayerController*> PCs = GetPlayerControllers();
-	for (APlayerController* PC : PCs)
+	for (APlayerController* PC : GetPlayerControllers())
 	{
 		if (UEnhancedInputLocalPlayerSubsystem* Subsystem = ULocalPlayer::GetSubsystem<UEnhancedInputLocalPlayerSubsystem>(PC->GetLocalPlayer()))
 		{
@@ -163,25 +171,43 @@ void UGDMInputSystemComponent::RegisterInputComponentToGroup(UInputComponent* In
 		return;
 	}
 
-	TArray<TWeakObjectPtr<UInputComponent>>& Group = RegisteredInputGroups.FindOrAdd(GroupName);
-	if (Group.Contains(InputComponent))
+	const int32 GroupIndex = FindOrAddInputGroup(GroupName);
+	if (FindInputEntry(InputComponent, GroupIndex) != INDEX_NONE)
 	{
 		/* 既に登録済みであればその場合、なにもしない */
 		return;
 	}
+
+	/* グループの末尾に繋ぐ */
+	FInputGroup& Group = InputGroups[GroupIndex];
+	FInputEntry NewEntry;
+	NewEntry.InputComponent    = InputComponent;
+	NewEntry.InputComponentKey = InputComponent;
+	NewEntry.GroupIndex        = GroupIndex;
+	NewEntry.PrevIndex         = Group.TailIndex;
 	
-	Group.Add(InputComponent);
+	const int32 EntryIndex = InputEntries.Add(MoveTemp(NewEntry));
+	if (Group.TailIndex != INDEX_NONE)
+	{
+		InputEntries[Group.TailIndex].NextIndex = EntryIndex;
+	}
+	else
+	{
+		Group.HeadIndex = EntryIndex;
+	}
+	Group.TailIndex = EntryIndex;
+	InputEntryIndices.Add(MakeTuple(InputEntries[EntryIndex].InputComponentKey, GroupIndex), EntryIndex);
 
 	if (GroupName == CurrentInputGroupName && bMenuOpen)
 	{
 		/* 現在のグループを指定し、メニューが開いていればコントローラーに追加 */
-		TArray<APlayerController*> PCs = GetPlayerControllers();
-		for (APlayerController* PC : PCs)
+		for (APlayerController* PC : GetPlayerControllers())
 		{
 			PC->PushInputComponent(InputComponent);
 		}
 		
-		ActiveInputStacks.FindOrAdd(GroupName).AddUnique(InputComponent);
+		ActivateInputEntry(EntryIndex);
+		bDebugLogTextDirty = true;
 	}
 }
 
@@ -205,22 +231,29 @@ void UGDMInputSystemComponent::UnregisterInputComponentFromGroup(UInputComponent
 		return;
 	}
 
-	if (RegisteredInputGroups.Contains(GroupName))
+	const int32* GroupIndex = InputGroupIndices.Find(GroupName);
+	if (GroupIndex == nullptr)
 	{
-		RegisteredInputGroups[GroupName].Remove(InputComponent);
+		return;
 	}
 
-	if (ActiveInputStacks.Contains(GroupName))
+	const int32 EntryIndex = FindInputEntry(InputComponent, *GroupIndex);
+	if (EntryIndex == INDEX_NONE)
 	{
-		if (ActiveInputStacks[GroupName].Remove(InputComponent) > 0)
+		return;
+	}
+
+	if (InputEntries[EntryIndex].bActive)
+	{
+		for (APlayerController* PC : GetPlayerControllers())
 		{
-			TArray<APlayerController*> PCs = GetPlayerControllers();
-			for (APlayerController* PC : PCs)
-			{
-				PC->PopInputComponent(InputComponent);
-			}
+			PC->PopInputComponent(InputComponent);
 		}
+
+		bDebugLogTextDirty = true;
 	}
+
+	RemoveInputEntry(EntryIndex);
 }
 
 void UGDMInputSystemComponent::SwitchToInputGroup(const FName NewGroupName)
@@ -230,45 +263,65 @@ void UGDMInputSystemComponent::SwitchToInputGroup(const FName NewGroupName)
 		return;
 	}
 
-	TArray<APlayerController*> PCs = GetPlayerControllers();
+	const auto PCs = GetPlayerControllers();
 	
 	/* 現在のグループのInputComponentを除外 */
-	if (TArray<TWeakObjectPtr<UInputComponent>>* Stack = ActiveInputStacks.Find(CurrentInputGroupName))
+	if (const int32* CurrentGroupIndex = InputGroupIndices.Find(CurrentInputGroupName))
 	{
-		for (const auto& Comp : *Stack)
-		{
-			if (Comp.IsValid())
-			{
-				for (APlayerController* PC : PCs)
-				{
-					PC->PopInputComponent(Comp.Get());
-				}
-			}
-		}
-		
-		Stack->Reset();
+		DeactivateInputGroup(*CurrentGroupIndex, PCs);
 	}
 	
 	CurrentInputGroupName = NewGroupName;
+	bDebugLogTextDirty = true;
 
 	/* 新しいグループのInputComponentを追加 */
-	if (const TArray<TWeakObjectPtr<UInputComponent>>* NewStack = RegisteredInputGroups.Find(NewGroupName))
+	if (const int32* NewGroupIndex = InputGroupIndices.Find(NewGroupName))
 	{
-		for (const auto& Comp : *NewStack)
+		ActivateInputGroup(*NewGroupIndex);
+		
+		for (int32 EntryIndex = InputGroups[*NewGroupIndex].HeadIndex; EntryIndex != INDEX_NONE; EntryIndex = InputEntries[EntryIndex].NextIndex)
 		{
-			if (Comp.IsValid())
+			UInputComponent* InputComponent = InputEntries[EntryIndex].InputComponent.Get();
+			for (APlayerController* PC : PCs)
 			{
-				for (APlayerController* PC : PCs)
-				{
-					PC->PushInputComponent(Comp.Get());
-				}
-				
-				ActiveInputStacks.FindOrAdd(NewGroupName).AddUnique(Comp);
+				PC->PushInputComponent(InputComponent);
 			}
 		}
 	}
 }
 
+bool UGDMInputSystemComponent::IsInputComponentActive(const UInputComponent* InputComponent) const
+{
+	const int32* GroupIndex = InputGroupIndices.Find(CurrentInputGroupName);
+	if (GroupIndex == nullptr)
+	{
+		return false;
+	}
+
+	/* アクティブになるのは現在のグループのEntryだけ */
+	const int32 EntryIndex = FindInputEntry(InputComponent, *GroupIndex);
+	return (EntryIndex != INDEX_NONE) && InputEntries[EntryIndex].bActive;
+}
+
+UInputComponent* UGDMInputSystemComponent::GetTopActiveInputComponent(const FName GroupName) const
+{
+	const int32* GroupIndex = InputGroupIndices.Find(GroupName);
+	if (GroupIndex == nullptr)
+	{
+		return nullptr;
+	}
+
+	/* GCされたEntryは次にグループをアクティブにするまで残るので飛ばす */
+	for (int32 EntryIndex = InputGroups[*GroupIndex].TopActiveIndex; EntryIndex != INDEX_NONE; EntryIndex = InputEntries[EntryIndex].ActivePrevIndex)
+	{
+		if (UInputComponent* InputComponent = InputEntries[EntryIndex].InputComponent.Get())
+		{
+			return InputComponent;
+		}
+	}
+	return nullptr;
+}
+
 void UGDMInputSystemComponent::OnOpenMenu()
 {
 	if (bMenuOpen)
@@ -277,21 +330,15 @@ void UGDMInputSystemComponent::OnOpenMenu()
 	}
 
 	bMenuOpen = true;
+	bDebugLogTextDirty = true;
 
-	const TArray<TWeakObjectPtr<UInputComponent>>* Group = RegisteredInputGroups.Find(CurrentInputGroupName);
-	if (Group != nullptr)
+	const int32* GroupIndex = InputGroupIndices.Find(CurrentInputGroupName);
+	if (GroupIndex != nullptr)
 	{
-		for (const auto& Comp : *Group)
-		{
-			if (Comp.IsValid())
-			{
-				ActiveInputStacks.FindOrAdd(CurrentInputGroupName).AddUnique(Comp);
-			}
-		}
+		ActivateInputGroup(*GroupIndex);
 	}
 	
-	TArray<APlayerController*> PCs = GetPlayerControllers();
-	for (APlayerController* PC : PCs)
+	for (APlayerController* PC : GetPlayerControllers())
 	{
 		if(UEnhancedInputLocalPlayerSubsystem* Subsystem = ULocalPlayer::GetSubsystem<UEnhancedInputLocalPlayerSubsystem>(PC->GetLocalPlayer()))
 		{
@@ -309,14 +356,11 @@ void UGDMInputSystemComponent::OnOpenMenu()
 			PC->PushInputComponent(RootWidgetInputComponent);
 		}
 		
-		if (Group != nullptr)
+		if (GroupIndex != nullptr)
 		{
-			for (const auto& Comp : *Group)
+			for (int32 EntryIndex = InputGroups[*GroupIndex].HeadIndex; EntryIndex != INDEX_NONE; EntryIndex = InputEntries[EntryIndex].NextIndex)
 			{
-				if (Comp.IsValid())
-				{
-					PC->PushInputComponent(Comp.Get());
-				}
+				PC->PushInputComponent(InputEntries[EntryIndex].InputComponent.Get());
 			}
 		}
 	}
@@ -330,9 +374,10 @@ void UGDMInputSystemComponent::OnCloseMenu()
 	}
 	
 	bMenuOpen = false;
+	bDebugLogTextDirty = true;
 	
-	TArray<TWeakObjectPtr<UInputComponent>>* Stack = ActiveInputStacks.Find(CurrentInputGroupName);
-	TArray<APlayerController*> PCs = GetPlayerControllers();
+	const int32* GroupIndex = InputGroupIndices.Find(CurrentInputGroupName);
+	const auto PCs = GetPlayerControllers();
 	for (APlayerController* PC : PCs)
 	{
 		if(UEnhancedInputLocalPlayerSubsystem* Subsystem = ULocalPlayer::GetSubsystem<UEnhancedInputLocalPlayerSubsystem>(PC->GetLocalPlayer()))
@@ -342,28 +387,20 @@ void UGDMInputSystemComponent::OnCloseMenu()
 				Subsystem->RemoveMappingContext(Data.InputMappingContext);
 			}
 		}
+	}
 
-		if (Stack != nullptr)
-		{
-			for (const auto& Comp : *Stack)
-			{
-				if (Comp.IsValid())
-				{
-					PC->PopInputComponent(Comp.Get());
-				}
-			}
-		}
-		
-		if (IsValid(RootWidgetInputComponent))
+	if (GroupIndex != nullptr)
+	{
+		DeactivateInputGroup(*GroupIndex, PCs);
+	}
+	
+	if (IsValid(RootWidgetInputComponent))
+	{
+		for (APlayerController* PC : PCs)
 		{
 			PC->PopInputComponent(RootWidgetInputComponent);
 		}
 	}
-
-	if (Stack != nullptr)
-	{
-		Stack->Reset();
-	}
 }
 
 void UGDMInputSystemComponent::CreateDebugCameraInputClass(TSubclassOf<AGDMDebugCameraInput> DebugCameraInputClass)
@@ -401,9 +438,9 @@ AGameDebugMenuManager* UGDMInputSystemComponent::GetOwnerGameDebugMenuManager()
 	return Cast<AGameDebugMenuManager>(GetOwner());
 }
 
-TArray<APlayerController*> UGDMInputSystemComponent::GetPlayerControllers() const
+TArray<APlayerController*, TInlineAllocator<2>> UGDMInputSystemComponent::GetPlayerControllers() const
 {
-	TArray<APlayerController*> ReturnValues;
+	TArray<APlayerController*, TInlineAllocator<2>> ReturnValues;
 	
 	if (APlayerController* TargetPC = GetOwnerGameDebugMenuManager()->GetOwnerPlayerController())
 	{
@@ -459,3 +496,184 @@ void UGDMInputSystemComponent::OnActorSpawned(AActor* SpawnActor)
 		}
 	}));
 }
+
+void UGDMInputSystemComponent::RebuildDebugLogText()
+{
+	bDebugLogTextDirty = false;
+	CachedDebugLogText.Reset();
+	CachedDebugLogInputComponents.Reset();
+
+	const AGameDebugMenuManager* Manager = GetOwnerGameDebugMenuManager();
+	UGDMLocalizeStringComponent* LocalizeStringComponent = Manager->GetLocalizeStringComponent();
+	CachedDebugLogLanguage = LocalizeStringComponent->GetCurrentDebugMenuLanguage();
+
+	FString GroupName;
+	LocalizeStringComponent->GetString(CurrentInputGroupName.ToString(), GroupName);
+	
+	CachedDebugLogText += FString::Printf(TEXT("[GameDebugMenu] Input Current Group: %s\n"), *GroupName);
+	
+	if (const int32* GroupIndex = InputGroupIndices.Find(CurrentInputGroupName))
+	{
+		for (int32 EntryIndex = InputGroups[*GroupIndex].HeadIndex; EntryIndex != INDEX_NONE; EntryIndex = InputEntries[EntryIndex].NextIndex)
+		{
+			const FInputEntry& Entry = InputEntries[EntryIndex];
+			if (!Entry.bActive)
+			{
+				continue;
+			}
+			
+			if (const UInputComponent* Input = Entry.InputComponent.Get())
+			{
+				const UObject* Outer = Input->GetOuter();
+				FString OuterLabel = TEXT("(null)");
+				if (IsValid(Outer))
+				{
+					FString AssetName;
+					Outer->GetFullName(nullptr).Split(TEXT("."), nullptr, &AssetName,  ESearchCase::IgnoreCase, ESearchDir::FromEnd);
+					OuterLabel = AssetName;
+				}
+				CachedDebugLogText += FString::Printf(TEXT("    > %s\n"), *OuterLabel);
+				CachedDebugLogInputComponents.Add(Input);
+			}
+		}
+	}
+}
+
+int32 UGDMInputSystemComponent::FindOrAddInputGroup(const FName GroupName)
+{
+	if (const int32* GroupIndex = InputGroupIndices.Find(GroupName))
+	{
+		return *GroupIndex;
+	}
+
+	const int32 GroupIndex = InputGroups.AddDefaulted();
+	InputGroups[GroupIndex].GroupName = GroupName;
+	InputGroupIndices.Add(GroupName, GroupIndex);
+	return GroupIndex;
+}
+
+int32 UGDMInputSystemComponent::FindInputEntry(const UInputComponent* InputComponent, const int32 GroupIndex) const
+{
+	const int32* EntryIndex = InputEntryIndices.Find(MakeTuple(TObjectKey<UInputComponent>(InputComponent), GroupIndex));
+	return (EntryIndex != nullptr) ? *EntryIndex : INDEX_NONE;
+}
+
+void UGDMInputSystemComponent::RemoveInputEntry(const int32 EntryIndex)
+{
+	if (InputEntries[EntryIndex].bActive)
+	{
+		DeactivateInputEntry(EntryIndex);
+	}
+
+	const FInputEntry& Entry = InputEntries[EntryIndex];
+	FInputGroup& Group = InputGroups[Entry.GroupIndex];
+	
+	if (Entry.PrevIndex != INDEX_NONE)
+	{
+		InputEntries[Entry.PrevIndex].NextIndex = Entry.NextIndex;
+	}
+	else
+	{
+		Group.HeadIndex = Entry.NextIndex;
+	}
+	
+	if (Entry.NextIndex != INDEX_NONE)
+	{
+		InputEntries[Entry.NextIndex].PrevIndex = Entry.PrevIndex;
+	}
+	else
+	{
+		Group.TailIndex = Entry.PrevIndex;
+	}
+
+	InputEntryIndices.Remove(MakeTuple(Entry.InputComponentKey, Entry.GroupIndex));
+	InputEntries.RemoveAt(EntryIndex);
+}
+
+void UGDMInputSystemComponent::ActivateInputEntry(const int32 EntryIndex)
+{
+	FInputEntry& Entry = InputEntries[EntryIndex];
+	FInputGroup& Group = InputGroups[Entry.GroupIndex];
+	
+	/* アクティブにしたものが最上位になるので末尾に繋ぐ */
+	Entry.bActive = true;
+	Entry.ActivePrevIndex = Group.TopActiveIndex;
+	Entry.ActiveNextIndex = INDEX_NONE;
+	if (Group.TopActiveIndex != INDEX_NONE)
+	{
+		InputEntries[Group.TopActiveIndex].ActiveNextIndex = EntryIndex;
+	}
+	Group.TopActiveIndex = EntryIndex;
+}
+
+void UGDMInputSystemComponent::DeactivateInputEntry(const int32 EntryIndex)
+{
+	FInputEntry& Entry = InputEntries[EntryIndex];
+	FInputGroup& Group = InputGroups[Entry.GroupIndex];
+	
+	/* アクティブなリストから外す（最上位が外れたら手前のEntryが最上位になる） */
+	if (Entry.ActivePrevIndex != INDEX_NONE)
+	{
+		InputEntries[Entry.ActivePrevIndex].ActiveNextIndex = Entry.ActiveNextIndex;
+	}
+	
+	if (Entry.ActiveNextIndex != INDEX_NONE)
+	{
+		InputEntries[Entry.ActiveNextIndex].ActivePrevIndex = Entry.ActivePrevIndex;
+	}
+	else
+	{
+		Group.TopActiveIndex = Entry.ActivePrevIndex;
+	}
+
+	Entry.bActive = false;
+	Entry.ActivePrevIndex = INDEX_NONE;
+	Entry.ActiveNextIndex = INDEX_NONE;
+}
+
+void UGDMInputSystemComponent::ActivateInputGroup(const int32 GroupIndex)
+{
+	int32 EntryIndex = InputGroups[GroupIndex].HeadIndex;
+	while (EntryIndex != INDEX_NONE)
+	{
+		const int32 NextIndex = InputEntries[EntryIndex].NextIndex;
+		
+		if (!InputEntries[EntryIndex].InputComponent.IsValid())
+		{
+			RemoveInputEntry(EntryIndex);
+		}
+		else if (!InputEntries[EntryIndex].bActive)
+		{
+			ActivateInputEntry(EntryIndex);
+		}
+		
+		EntryIndex = NextIndex;
+	}
+}
+
+void UGDMInputSystemComponent::DeactivateInputGroup(const int32 GroupIndex, TConstArrayView<APlayerController*> PCs)
+{
+	FInputGroup& Group = InputGroups[GroupIndex];
+	for (int32 EntryIndex = Group.HeadIndex; EntryIndex != INDEX_NONE; EntryIndex = InputEntries[EntryIndex].NextIndex)
+	{
+		FInputEntry& Entry = InputEntries[EntryIndex];
+		if (!Entry.bActive)
+		{
+			continue;
+		}
+		
+		if (UInputComponent* InputComponent = Entry.InputComponent.Get())
+		{
+			for (APlayerController* PC : PCs)
+			{
+				PC->PopInputComponent(InputComponent);
+			}
+		}
+		
+		Entry.bActive = false;
+		Entry.ActivePrevIndex = INDEX_NONE;
+		Entry.ActiveNextIndex = INDEX_NONE;
+	}
+
+	Group.TopActiveIndex = INDEX_NONE;
+}
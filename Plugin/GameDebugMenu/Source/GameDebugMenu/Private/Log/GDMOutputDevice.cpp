@@ -7,26 +7,187 @@
 
 #include "Log/GDMOutputDevice.h"
 #include "HAL/CriticalSection.h"
+#include "HAL/PlatformTime.h"
+#include "Algo/BinarySearch.h"
+#include "Async/Async.h"
+#include "Misc/Compression.h"
+#include "Misc/FileHelper.h"
 #include <CoreGlobals.h>
 #include <Misc/OutputDeviceHelper.h>
 
 #include "GameDebugMenuSettings.h"
 
-FGDMOutputDevice::FGDMOutputDevice()
+DECLARE_STATS_GROUP(TEXT("GameDebugMenu"), STATGROUP_GameDebugMenu, STATCAT_Advanced);
+DECLARE_MEMORY_STAT(TEXT("Log Buffer Memory"), STAT_GDMLogBufferMemory, STATGROUP_GameDebugMenu);
+
+namespace
+{
+	/* 1行の最大文字数（これを超える行は折り返す） */
+	constexpr int32 HardWrapLen = 360;
+
+	/* "[YYYY.MM.DD-HH.MM.SS:mmm][fff]" の文字数 */
+	constexpr int32 LogTimestampPrefixLen = 30;
+
+	/* ログ本文用チャンクの文字数 */
+	constexpr int32 LogTextChunkSize = 32 * 1024;
+
+	/* 書き出し時の進捗通知の間隔（行数） */
+	constexpr int32 ExportProgressInterval = 5000;
+
+	FString FormatLogLineImpl(const FGDMLogLine& Line, const FGDMLogLineStamp& Stamp, const TCHAR* Text, const FDateTime& CaptureStartUtc, double CaptureStartTime)
+	{
+		FString Result;
+		if (Line.bFirstLineInMessage)
+		{
+			const FDateTime Utc = CaptureStartUtc + FTimespan::FromSeconds(Stamp.Time - CaptureStartTime);
+			Result = FString::Printf(TEXT("[%s][%3llu]"), *Utc.ToString(TEXT("%Y.%m.%d-%H.%M.%S:%s")), Stamp.Frame % 1000);
+			Result += FOutputDeviceHelper::FormatLogLine(static_cast<ELogVerbosity::Type>(Line.Verbosity), Line.Category, nullptr, ELogTimes::None);
+		}
+
+		Result.AppendChars(Text, Line.Len);
+
+		if (Line.RepeatCount > 1)
+		{
+			Result += FString::Printf(TEXT(" (x%d)"), Line.RepeatCount);
+		}
+
+		return Result;
+	}
+}
+
+/********************************************************************/
+/* FGDMLogSnapshot								    				*/
+/********************************************************************/
+
+FString FGDMLogSnapshot::FormatLogLine(int32 Index) const
+{
+	const FGDMLogLine& Line = Lines[Index];
+	return FormatLogLineImpl(Line, Stamps[Index], TextChunks[Line.ChunkIndex]->GetData() + Line.Offset, CaptureStartUtc, CaptureStartTime);
+}
+
+/********************************************************************/
+/* FGDMCommandFilterTrie						    				*/
+/********************************************************************/
+
+void FGDMCommandFilterTrie::Build(const TArray<FString>& Patterns)
+{
+	Nodes.Reset();
+	Nodes.AddDefaulted();
+
+	for (const FString& Pattern : Patterns)
+	{
+		if (Pattern.IsEmpty())
+		{
+			continue;
+		}
+
+		int32 NodeIndex = 0;
+		for (const TCHAR Char : Pattern)
+		{
+			const TCHAR Key = FChar::ToLower(Char);
+			if (const int32* Child = Nodes[NodeIndex].Children.Find(Key))
+			{
+				NodeIndex = *Child;
+			}
+			else
+			{
+				const int32 NewIndex = Nodes.AddDefaulted();
+				Nodes[NodeIndex].Children.Add(Key, NewIndex);
+				NodeIndex = NewIndex;
+			}
+		}
+
+		Nodes[NodeIndex].bTerminal = true;
+	}
+}
+
+bool FGDMCommandFilterTrie::ContainsAny(const FString& Str) const
+{
+	if (Nodes.Num() <= 1)
+	{
+		return false;
+	}
+
+	/* FString::Containsと同じく大文字小文字は区別しない */
+	const int32 Len = Str.Len();
+	for (int32 Start = 0; Start < Len; ++Start)
+	{
+		int32 NodeIndex = 0;
+		for (int32 Index = Start; Index < Len; ++Index)
+		{
+			const int32* Child = Nodes[NodeIndex].Children.Find(FChar::ToLower(Str[Index]));
+			if (Child == nullptr)
+			{
+				break;
+			}
+
+			NodeIndex = *Child;
+			if (Nodes[NodeIndex].bTerminal)
+			{
+				return true;
+			}
+		}
+	}
+
+	return false;
+}
+
+/********************************************************************/
+/* FGDMOutputDevice								    				*/
+/********************************************************************/
+
+FGDMOutputDevice::FGDMOutputDevice(bool bRegisterToLog)
 	: FOutputDevice()
-	, Logs()
+	, LogTextChunks()
+	, LogLines()
+	, LogStamps()
+	, LastRepeatStamps()
+	, CaptureStartUtc(FDateTime::UtcNow())
+	, CaptureStartTime(FPlatformTime::Seconds())
+	, bCollapseRepeatedLines(false)
+	, LogTextChunkBytes(0)
+	, ReportedLogMemory(0)
+	, bRegisteredToLog(bRegisterToLog)
+	, CommandHistory()
+	, OldestCommandHistoryIndex(INDEX_NONE)
+	, NewestCommandHistoryIndex(INDEX_NONE)
+	, CommandHistoryNum(0)
+	, CommandHistoryIndices()
+	, NoSaveCommandFilter()
 {
-	Logs.Reserve(10000);
-	CommandHistory.Reserve(100);
-	GLog->AddOutputDevice(this);
+	const UGameDebugMenuSettings* Settings = GetDefault<UGameDebugMenuSettings>();
+
+	bCollapseRepeatedLines = Settings->bCollapseRepeatedLogLines;
+	LogLines.Reserve(10000);
+	LogStamps.Reserve(10000);
+	ApplyCommandHistorySettings();
+
+#if WITH_EDITOR
+	/* Project Settingsでの変更を反映する */
+	SettingsChangedHandle = GetMutableDefault<UGameDebugMenuSettings>()->OnSettingChanged().AddRaw(this, &FGDMOutputDevice::OnSettingsChanged);
+#endif
+
+	if (bRegisteredToLog)
+	{
+		GLog->AddOutputDevice(this);
+	}
 }
 
 FGDMOutputDevice::~FGDMOutputDevice()
 {
-	if(GLog != nullptr)
+	if(bRegisteredToLog && GLog != nullptr)
 	{
 		GLog->RemoveOutputDevice(this);
 	}
+
+#if WITH_EDITOR
+	if (SettingsChangedHandle.IsValid() && UObjectInitialized())
+	{
+		GetMutableDefault<UGameDebugMenuSettings>()->OnSettingChanged().Remove(SettingsChangedHandle);
+	}
+#endif
+
+	DEC_MEMORY_STAT_BY(STAT_GDMLogBufferMemory, ReportedLogMemory);
 }
 
 void FGDMOutputDevice::Serialize(const TCHAR* Data, ELogVerbosity::Type Verbosity, const class FName& Category, const double Time)
@@ -47,36 +208,22 @@ void FGDMOutputDevice::Serialize(const TCHAR* Data, ELogVerbosity::Type Verbosit
 
 		if (Category == CommandCategory)
 		{
-			while(CommandHistory.Num() > GetDefault<UGameDebugMenuSettings>()->MaxCommandHistoryNum - 1)
-			{
-				CommandHistory.RemoveAt(0);
-			}
-
-			bool bAdd = true;
-			const FString CheckStr = Data;
-			for (const auto& C : GetDefault<UGameDebugMenuSettings>()->NoSaveConsoleCommands)
-			{
-				if (CheckStr.Contains(C))
-				{
-					bAdd = false;
-					break;
-				}
-			}
-
-			if (bAdd)
-			{
-				CommandHistory.Add(Data);
-			}
+			AddCommandHistory(Data);
 		}
-		
-		/* 時間はUTCで固定し他はエディターの「outputlog」のものと同じものを保持しとく */
-		static ELogTimes::Type LogTimestampMode = ELogTimes::UTC;
 
 		// handle multiline strings by breaking them apart by line
 		TArray<FTextRange> LineRanges;
 		FString CurrentLogDump = Data;
 		FTextRange::CalculateLineRangesFromString(CurrentLogDump, LineRanges);
 
+		FScopeLock Lock(&LogsMutex);
+
+		/* 取り込み順に単調増加させるためロック内で取得する */
+		const FGDMLogLineStamp Stamp{ FPlatformTime::Seconds(), GFrameCounter };
+
+		/* 行頭の書式（時間はUTCで固定し他はエディターの「outputlog」のものと同じ）は取得時に組み立てるので、ここでは折り返し幅の計算にだけ使う */
+		const int32 MessagePrefixLen = LogTimestampPrefixLen + FOutputDeviceHelper::FormatLogLine(Verbosity, Category, nullptr, ELogTimes::None).Len();
+
 		bool bIsFirstLineInMessage = true;
 		for(const FTextRange& LineRange : LineRanges)
 		{
@@ -85,50 +232,418 @@ void FGDMOutputDevice::Serialize(const TCHAR* Data, ELogVerbosity::Type Verbosit
 				FString Line = CurrentLogDump.Mid(LineRange.BeginIndex, LineRange.Len());
 				Line = Line.ConvertTabsToSpaces(4);
 
-				// Hard-wrap lines to avoid them being too long
-				static const int32 HardWrapLen = 360;
-				for(int32 CurrentStartIndex = 0; CurrentStartIndex < Line.Len();)
+				/* 1行で収まるメッセージは直前と同じなら回数だけ増やす */
+				if (bCollapseRepeatedLines && LineRanges.Num() == 1 && Line.Len() <= HardWrapLen - MessagePrefixLen)
 				{
-					int32 HardWrapLineLen = 0;
-					if(bIsFirstLineInMessage)
+					if (TryCollapseLogLine(*Line, Line.Len(), Category, Verbosity, Stamp))
 					{
-						FString MessagePrefix = FOutputDeviceHelper::FormatLogLine(Verbosity, Category, nullptr, LogTimestampMode);
-
-						HardWrapLineLen = FMath::Min(HardWrapLen - MessagePrefix.Len(), Line.Len() - CurrentStartIndex);
-						FString HardWrapLine = Line.Mid(CurrentStartIndex, HardWrapLineLen);
-
-						Logs.Add(MessagePrefix + HardWrapLine);
+						break;
 					}
-					else
-					{
-						HardWrapLineLen = FMath::Min(HardWrapLen, Line.Len() - CurrentStartIndex);
-						FString HardWrapLine = Line.Mid(CurrentStartIndex, HardWrapLineLen);
+				}
 
-						Logs.Add(MoveTemp(HardWrapLine));
-					}
+				// Hard-wrap lines to avoid them being too long
+				for(int32 CurrentStartIndex = 0; CurrentStartIndex < Line.Len();)
+				{
+					const int32 WrapLen = bIsFirstLineInMessage ? FMath::Max(HardWrapLen - MessagePrefixLen, 1) : HardWrapLen;
+					const int32 HardWrapLineLen = FMath::Min(WrapLen, Line.Len() - CurrentStartIndex);
+
+					AddLogLine(*Line + CurrentStartIndex, HardWrapLineLen, Category, Verbosity, bIsFirstLineInMessage, Stamp);
 
 					bIsFirstLineInMessage = false;
 					CurrentStartIndex += HardWrapLineLen;
 				}
 			}
 		}
+
+		UpdateLogMemoryStat();
+	}
+}
+
+void FGDMOutputDevice::AddLogLine(const TCHAR* Text, int32 Len, const FName& Category, ELogVerbosity::Type Verbosity, bool bFirstLineInMessage, const FGDMLogLineStamp& Stamp)
+{
+	check(Len <= LogTextChunkSize);
+
+	if (LogTextChunks.Num() == 0 || LogTextChunks.Last()->Num() + Len > LogTextChunkSize)
+	{
+		TArray<TCHAR>& NewChunk = LogTextChunks.Add_GetRef(MakeShared<TArray<TCHAR>, ESPMode::ThreadSafe>()).Get();
+		NewChunk.Reserve(LogTextChunkSize);
+		LogTextChunkBytes += NewChunk.GetAllocatedSize();
+	}
+
+	TArray<TCHAR>& Chunk = LogTextChunks.Last().Get();
+
+	FGDMLogLine& NewLine = LogLines.AddDefaulted_GetRef();
+	NewLine.Category = Category;
+	NewLine.ChunkIndex = LogTextChunks.Num() - 1;
+	NewLine.Offset = Chunk.Num();
+	NewLine.Len = static_cast<uint16>(Len);
+	NewLine.Verbosity = static_cast<uint8>(Verbosity & ELogVerbosity::VerbosityMask);
+	NewLine.bFirstLineInMessage = bFirstLineInMessage;
+	NewLine.RepeatCount = 1;
+
+	Chunk.Append(Text, Len);
+	LogStamps.Add(Stamp);
+}
+
+bool FGDMOutputDevice::TryCollapseLogLine(const TCHAR* Text, int32 Len, const FName& Category, ELogVerbosity::Type Verbosity, const FGDMLogLineStamp& Stamp)
+{
+	if (LogLines.Num() == 0)
+	{
+		return false;
 	}
+
+	/* 最後の行が1行のメッセージの先頭行であること */
+	FGDMLogLine& LastLine = LogLines.Last();
+	if (!LastLine.bFirstLineInMessage || LastLine.Category != Category || LastLine.Verbosity != (Verbosity & ELogVerbosity::VerbosityMask) || LastLine.Len != Len)
+	{
+		return false;
+	}
+
+	const TCHAR* LastText = LogTextChunks[LastLine.ChunkIndex]->GetData() + LastLine.Offset;
+	if (FCString::Strncmp(LastText, Text, Len) != 0)
+	{
+		return false;
+	}
+
+	++LastLine.RepeatCount;
+
+	/* 最初に出力された時間はそのまま残し、範囲取得用に最後の時間を別に持つ */
+	LastRepeatStamps.Add(LogLines.Num() - 1, Stamp);
+	return true;
+}
+
+FString FGDMOutputDevice::FormatLogLine(int32 Index) const
+{
+	const FGDMLogLine& Line = LogLines[Index];
+	return FormatLogLineImpl(Line, LogStamps[Index], LogTextChunks[Line.ChunkIndex]->GetData() + Line.Offset, CaptureStartUtc, CaptureStartTime);
 }
 
 TArray<FString> FGDMOutputDevice::GetLogs() const
 {
-	FScopeLock Lock(&CommandHistoryMutex);
-	return Logs;
+	FScopeLock Lock(&LogsMutex);
+	return CopyLogs(0, LogLines.Num());
+}
+
+TArray<FString> FGDMOutputDevice::GetLogsInTimeRange(double StartTime, double EndTime) const
+{
+	FScopeLock Lock(&LogsMutex);
+
+	const int32 First = IncludeRepeatedLogLine(Algo::LowerBoundBy(LogStamps, StartTime, &FGDMLogLineStamp::Time), StartTime, 0, false);
+	const int32 Last  = Algo::UpperBoundBy(LogStamps, EndTime, &FGDMLogLineStamp::Time);
+	return CopyLogs(First, Last);
+}
+
+TArray<FString> FGDMOutputDevice::GetLogsInFrameRange(uint64 StartFrame, uint64 EndFrame) const
+{
+	FScopeLock Lock(&LogsMutex);
+
+	const int32 First = IncludeRepeatedLogLine(Algo::LowerBoundBy(LogStamps, StartFrame, &FGDMLogLineStamp::Frame), 0.0, StartFrame, true);
+	const int32 Last  = Algo::UpperBoundBy(LogStamps, EndFrame, &FGDMLogLineStamp::Frame);
+	return CopyLogs(First, Last);
+}
+
+int32 FGDMOutputDevice::IncludeRepeatedLogLine(int32 First, double StartTime, uint64 StartFrame, bool bByFrame) const
+{
+	/* まとめられるのは常に最後の行なので、範囲の開始より前から続いている可能性があるのは直前の1行だけ */
+	if (First > 0)
+	{
+		if (const FGDMLogLineStamp* LastRepeatStamp = LastRepeatStamps.Find(First - 1))
+		{
+			if (bByFrame ? LastRepeatStamp->Frame >= StartFrame : LastRepeatStamp->Time >= StartTime)
+			{
+				return First - 1;
+			}
+		}
+	}
+
+	return First;
+}
+
+TArray<FString> FGDMOutputDevice::CopyLogs(int32 First, int32 Last) const
+{
+	TArray<FString> Result;
+	Result.Reserve(FMath::Max(Last - First, 0));
+
+	for (int32 Index = First; Index < Last; ++Index)
+	{
+		Result.Add(FormatLogLine(Index));
+	}
+
+	return Result;
+}
+
+SIZE_T FGDMOutputDevice::GetLogAllocatedSize() const
+{
+	FScopeLock Lock(&LogsMutex);
+	return ReportedLogMemory;
+}
+
+TSharedRef<FGDMLogSnapshot, ESPMode::ThreadSafe> FGDMOutputDevice::CreateSnapshot() const
+{
+	FScopeLock Lock(&LogsMutex);
+
+	TSharedRef<FGDMLogSnapshot, ESPMode::ThreadSafe> Snapshot = MakeShared<FGDMLogSnapshot, ESPMode::ThreadSafe>();
+	Snapshot->TextChunks = LogTextChunks;
+	if (Snapshot->TextChunks.Num() > 0)
+	{
+		/* 最後のチャンクはまだ追記されるので複製 */
+		Snapshot->TextChunks.Last() = MakeShared<TArray<TCHAR>, ESPMode::ThreadSafe>(LogTextChunks.Last().Get());
+	}
+	Snapshot->Lines = LogLines;
+	Snapshot->Stamps = LogStamps;
+	Snapshot->CaptureStartUtc = CaptureStartUtc;
+	Snapshot->CaptureStartTime = CaptureStartTime;
+	return Snapshot;
+}
+
+void FGDMOutputDevice::ExportLogsAsync(const FString& FilePath, bool bCompress, FGDMOnLogExportProgress OnProgress, FGDMOnLogExportCompleted OnCompleted) const
+{
+	TSharedRef<FGDMLogSnapshot, ESPMode::ThreadSafe> Snapshot = CreateSnapshot();
+
+	Async(EAsyncExecution::ThreadPool, [Snapshot, FilePath, bCompress, OnProgress, OnCompleted]()
+	{
+		auto NotifyProgress = [OnProgress](float Progress)
+		{
+			AsyncTask(ENamedThreads::GameThread, [OnProgress, Progress]()
+			{
+				OnProgress.ExecuteIfBound(Progress);
+			});
+		};
+
+		/* 整形とUTF8変換（全体の8割として進捗を通知） */
+		const int32 NumLines = Snapshot->Lines.Num();
+		TArray<uint8> Utf8Data;
+		Utf8Data.Reserve(NumLines * 96);
+		for (int32 Index = 0; Index < NumLines; ++Index)
+		{
+			const FString Line = Snapshot->FormatLogLine(Index) + LINE_TERMINATOR;
+			const FTCHARToUTF8 Converted(*Line, Line.Len());
+			Utf8Data.Append(reinterpret_cast<const uint8*>(Converted.Get()), Converted.Length());
+
+			if ((Index + 1) % ExportProgressInterval == 0)
+			{
+				NotifyProgress(0.8f * (Index + 1) / NumLines);
+			}
+		}
+
+		bool bSuccess = true;
+		TArray<uint8> CompressedData;
+		if (bCompress && Utf8Data.Num() > 0)
+		{
+			int32 CompressedSize = FCompression::CompressMemoryBound(NAME_Gzip, Utf8Data.Num());
+			CompressedData.SetNumUninitialized(CompressedSize);
+			bSuccess = FCompression::CompressMemory(NAME_Gzip, CompressedData.GetData(), CompressedSize, Utf8Data.GetData(), Utf8Data.Num());
+			CompressedData.SetNum(bSuccess ? CompressedSize : 0);
+			NotifyProgress(0.9f);
+		}
+
+		if (bSuccess)
+		{
+			bSuccess = FFileHelper::SaveArrayToFile(bCompress ? CompressedData : Utf8Data, *FilePath);
+		}
+
+		if (!bSuccess)
+		{
+			UE_LOG(LogGDM, Warning, TEXT("ExportLogsAsync: Failed %s"), *FilePath);
+		}
+
+		AsyncTask(ENamedThreads::GameThread, [OnProgress, OnCompleted, bSuccess, FilePath]()
+		{
+			OnProgress.ExecuteIfBound(1.0f);
+			OnCompleted.ExecuteIfBound(bSuccess, FilePath);
+		});
+	});
+}
+
+void FGDMOutputDevice::UpdateLogMemoryStat()
+{
+	/* チャンクは固定長で確保するので、毎回チャンクを辿らずに確保時の合計を使う */
+	const SIZE_T Size = LogTextChunkBytes + LogTextChunks.GetAllocatedSize() + LogLines.GetAllocatedSize() + LogStamps.GetAllocatedSize() + LastRepeatStamps.GetAllocatedSize();
+
+	if (Size > ReportedLogMemory)
+	{
+		INC_MEMORY_STAT_BY(STAT_GDMLogBufferMemory, Size - ReportedLogMemory);
+	}
+	else
+	{
+		DEC_MEMORY_STAT_BY(STAT_GDMLogBufferMemory, ReportedLogMemory - Size);
+	}
+
+	ReportedLogMemory = Size;
 }
 
 TArray<FString> FGDMOutputDevice::GetCommandHistory() const
 {
 	FScopeLock Lock(&CommandHistoryMutex);
-	return CommandHistory;
+
+	TArray<FString> Result;
+	Result.Reserve(CommandHistoryNum);
+
+	/* 同じコマンドは追加時に最新へ移しているので、古い順にそのまま返す */
+	for (int32 Index = OldestCommandHistoryIndex; Index != INDEX_NONE; Index = CommandHistory[Index].NextIndex)
+	{
+		Result.Add(CommandHistory[Index].Command);
+	}
+
+	return Result;
 }
 
 void FGDMOutputDevice::ClearCommandHistory()
 {
 	FScopeLock Lock(&CommandHistoryMutex);
+
+	for (FCommandHistoryEntry& Entry : CommandHistory)
+	{
+		Entry = FCommandHistoryEntry();
+	}
+
+	OldestCommandHistoryIndex = INDEX_NONE;
+	NewestCommandHistoryIndex = INDEX_NONE;
+	CommandHistoryNum = 0;
+	CommandHistoryIndices.Reset();
+}
+
+#if WITH_EDITOR
+void FGDMOutputDevice::OnSettingsChanged(UObject* Settings, FPropertyChangedEvent& PropertyChangedEvent)
+{
+	const FName PropertyName = PropertyChangedEvent.GetMemberPropertyName();
+	if (PropertyName == GET_MEMBER_NAME_CHECKED(UGameDebugMenuSettings, MaxCommandHistoryNum)
+		|| PropertyName == GET_MEMBER_NAME_CHECKED(UGameDebugMenuSettings, NoSaveConsoleCommands))
+	{
+		FScopeLock Lock(&CommandHistoryMutex);
+		ApplyCommandHistorySettings();
+	}
+}
+#endif
+
+void FGDMOutputDevice::ApplyCommandHistorySettings()
+{
+	const UGameDebugMenuSettings* Settings = GetDefault<UGameDebugMenuSettings>();
+
+	NoSaveCommandFilter.Build(Settings->NoSaveConsoleCommands);
+
+	const int32 Capacity    = CommandHistory.Num();
+	const int32 NewCapacity = FMath::Max(Settings->MaxCommandHistoryNum, 0);
+	if (NewCapacity == Capacity)
+	{
+		return;
+	}
+
+	/* 新しいものから入るだけ残して、古い順に先頭から詰め直す */
+	const int32 KeepNum = FMath::Min(CommandHistoryNum, NewCapacity);
+	TArray<FString, TInlineAllocator<64>> KeepCommands;
+	KeepCommands.SetNum(KeepNum);
+	int32 Index = NewestCommandHistoryIndex;
+	for (int32 Count = KeepNum - 1; Count >= 0; --Count)
+	{
+		KeepCommands[Count] = MoveTemp(CommandHistory[Index].Command);
+		Index = CommandHistory[Index].PrevIndex;
+	}
+
 	CommandHistory.Reset();
-}
\ No newline at end of file
+	CommandHistory.SetNum(NewCapacity);
+	OldestCommandHistoryIndex = INDEX_NONE;
+	NewestCommandHistoryIndex = INDEX_NONE;
+	CommandHistoryNum = 0;
+	CommandHistoryIndices.Reset();
+	CommandHistoryIndices.Reserve(NewCapacity);
+
+	for (FString& Command : KeepCommands)
+	{
+		const int32 NewIndex = CommandHistoryNum++;
+		CommandHistoryIndices.Add(Command, NewIndex);
+		CommandHistory[NewIndex].Command = MoveTemp(Command);
+		LinkNewestCommandHistory(NewIndex);
+	}
+}
+
+void FGDMOutputDevice::AddCommandHistory(const TCHAR* Command)
+{
+	const FString CommandString = Command;
+
+	FScopeLock Lock(&CommandHistoryMutex);
+
+	const int32 Capacity = CommandHistory.Num();
+	if (Capacity <= 0)
+	{
+		return;
+	}
+
+	if (NoSaveCommandFilter.ContainsAny(CommandString))
+	{
+		return;
+	}
+
+	if (const int32* ExistingIndex = CommandHistoryIndices.Find(CommandString))
+	{
+		/* 同じコマンドは新しい枠を使わずに最新へ移す */
+		const int32 Index = *ExistingIndex;
+		if (Index != NewestCommandHistoryIndex)
+		{
+			UnlinkCommandHistory(Index);
+			LinkNewestCommandHistory(Index);
+		}
+		return;
+	}
+
+	int32 Index = INDEX_NONE;
+	if (CommandHistoryNum == Capacity)
+	{
+		/* 一番古いものを使い回す */
+		Index = OldestCommandHistoryIndex;
+		UnlinkCommandHistory(Index);
+		CommandHistoryIndices.Remove(CommandHistory[Index].Command);
+	}
+	else
+	{
+		/* 埋まるまでは外さないので、空いている枠は常に末尾 */
+		Index = CommandHistoryNum++;
+	}
+
+	CommandHistory[Index].Command = CommandString;
+	CommandHistoryIndices.Add(CommandString, Index);
+	LinkNewestCommandHistory(Index);
+}
+
+void FGDMOutputDevice::LinkNewestCommandHistory(const int32 Index)
+{
+	FCommandHistoryEntry& Entry = CommandHistory[Index];
+	Entry.PrevIndex = NewestCommandHistoryIndex;
+	Entry.NextIndex = INDEX_NONE;
+
+	if (NewestCommandHistoryIndex != INDEX_NONE)
+	{
+		CommandHistory[NewestCommandHistoryIndex].NextIndex = Index;
+	}
+	else
+	{
+		OldestCommandHistoryIndex = Index;
+	}
+	NewestCommandHistoryIndex = Index;
+}
+
+void FGDMOutputDevice::UnlinkCommandHistory(const int32 Index)
+{
+	FCommandHistoryEntry& Entry = CommandHistory[Index];
+
+	if (Entry.PrevIndex != INDEX_NONE)
+	{
+		CommandHistory[Entry.PrevIndex].NextIndex = Entry.NextIndex;
+	}
+	else
+	{
+		OldestCommandHistoryIndex = Entry.NextIndex;
+	}
+
+	if (Entry.NextIndex != INDEX_NONE)
+	{
+		CommandHistory[Entry.NextIndex].PrevIndex = Entry.PrevIndex;
+	}
+	else
+	{
+		NewestCommandHistoryIndex = Entry.PrevIndex;
+	}
+
+	Entry.PrevIndex = INDEX_NONE;
+	Entry.NextIndex = INDEX_NONE;
+}
@@ -0,0 +1,179 @@
+/**
+* Copyright (c) 2020 akihiko moroi
+*
+* This software is released under the MIT License.
+* (See accompanying file LICENSE.txt or copy at http://opensource.org/licenses/MIT)
+*/
+
+#include "Log/GDMOutputDeviceBenchmark.h"
+#include "Async/Async.h"
+#include "HAL/PlatformMemory.h"
+#include "HAL/PlatformTime.h"
+#include "Math/RandomStream.h"
+#include <atomic>
+
+#include "GameDebugMenuTypes.h"
+#include "Log/GDMOutputDevice.h"
+
+namespace
+{
+	/* 実際のログに近い行の長さの分布でメッセージを用意する */
+	TArray<FString> BuildBenchmarkMessages(int32 Seed)
+	{
+		FRandomStream Random(Seed);
+
+		TArray<FString> Messages;
+		Messages.Reserve(256);
+		for (int32 Index = 0; Index < 256; ++Index)
+		{
+			const float Roll = Random.FRand();
+			int32 Len;
+			if (Roll < 0.70f)
+			{
+				Len = Random.RandRange(20, 80);		/* 短い通常のログ */
+			}
+			else if (Roll < 0.95f)
+			{
+				Len = Random.RandRange(80, 300);	/* パス等を含むログ */
+			}
+			else
+			{
+				Len = Random.RandRange(300, 1200);	/* 折り返しが発生する長いログ */
+			}
+
+			FString Message;
+			Message.Reserve(Len + 1);
+			for (int32 CharIndex = 0; CharIndex < Len; ++CharIndex)
+			{
+				Message.AppendChar(static_cast<TCHAR>(TEXT('a') + Random.RandRange(0, 25)));
+			}
+
+			if (Roll > 0.98f)
+			{
+				/* 複数行のログ */
+				Message.InsertAt(Len / 2, TEXT('\n'));
+			}
+
+			Messages.Add(MoveTemp(Message));
+		}
+
+		return Messages;
+	}
+}
+
+FGDMOutputDeviceBenchmark::FResult FGDMOutputDeviceBenchmark::Run(int32 NumThreads, int32 NumLinesPerThread)
+{
+	NumThreads = FMath::Max(NumThreads, 1);
+	NumLinesPerThread = FMath::Max(NumLinesPerThread, 1);
+
+	const FName Categories[] = { TEXT("LogTemp"), TEXT("LogGDM"), TEXT("LogNet"), TEXT("LogStreaming") };
+	const ELogVerbosity::Type Verbosities[] = { ELogVerbosity::Log, ELogVerbosity::Display, ELogVerbosity::Warning, ELogVerbosity::Verbose };
+
+	TArray<TArray<FString>> ThreadMessages;
+	TArray<TArray<uint64>> ThreadCycles;
+	ThreadMessages.SetNum(NumThreads);
+	ThreadCycles.SetNum(NumThreads);
+	for (int32 ThreadIndex = 0; ThreadIndex < NumThreads; ++ThreadIndex)
+	{
+		ThreadMessages[ThreadIndex] = BuildBenchmarkMessages(ThreadIndex + 1);
+		ThreadCycles[ThreadIndex].SetNumUninitialized(NumLinesPerThread);
+	}
+
+	/* 計測用のデータを用意した後の使用量を基準にする（プロセス全体のピークは起動時からの値なので使わない） */
+	const int64 BaselineUsedPhysical = static_cast<int64>(FPlatformMemory::GetStats().UsedPhysical);
+	int64 PeakUsedPhysical = BaselineUsedPhysical;
+
+	/* GLogには繋がず計測対象のデバイスだけに流す */
+	FGDMOutputDevice Device(/* bRegisterToLog */false);
+
+	std::atomic<int32> NumReady(0);
+	std::atomic<bool> bStart(false);
+
+	TArray<TFuture<void>> Futures;
+	Futures.Reserve(NumThreads);
+	for (int32 ThreadIndex = 0; ThreadIndex < NumThreads; ++ThreadIndex)
+	{
+		Futures.Add(Async(EAsyncExecution::Thread, [&, ThreadIndex]()
+		{
+			const TArray<FString>& Messages = ThreadMessages[ThreadIndex];
+			TArray<uint64>& Cycles = ThreadCycles[ThreadIndex];
+
+			/* 全スレッドが揃ってから同時に開始する */
+			++NumReady;
+			while (!bStart.load())
+			{
+				FPlatformProcess::Yield();
+			}
+
+			for (int32 LineIndex = 0; LineIndex < NumLinesPerThread; ++LineIndex)
+			{
+				const FString& Message = Messages[LineIndex % Messages.Num()];
+				const FName& Category = Categories[LineIndex % UE_ARRAY_COUNT(Categories)];
+				const ELogVerbosity::Type Verbosity = Verbosities[(LineIndex / 7) % UE_ARRAY_COUNT(Verbosities)];
+
+				const uint64 StartCycles = FPlatformTime::Cycles64();
+				Device.Serialize(*Message, Verbosity, Category);
+				Cycles[LineIndex] = FPlatformTime::Cycles64() - StartCycles;
+			}
+		}));
+	}
+
+	while (NumReady.load() < NumThreads)
+	{
+		FPlatformProcess::Yield();
+	}
+
+	const double StartTime = FPlatformTime::Seconds();
+	bStart = true;
+
+	/* 待っている間に使用量の最大値を取る */
+	for (TFuture<void>& Future : Futures)
+	{
+		while (!Future.WaitFor(FTimespan::FromMilliseconds(1.0)))
+		{
+			PeakUsedPhysical = FMath::Max(PeakUsedPhysical, static_cast<int64>(FPlatformMemory::GetStats().UsedPhysical));
+		}
+	}
+	const double EndTime = FPlatformTime::Seconds();
+	const int64 EndUsedPhysical = static_cast<int64>(FPlatformMemory::GetStats().UsedPhysical);
+
+	FResult Result;
+	Result.NumThreads = NumThreads;
+	Result.NumLines = NumThreads * NumLinesPerThread;
+	Result.TotalSeconds = EndTime - StartTime;
+	Result.LinesPerSecond = Result.NumLines / FMath::Max(Result.TotalSeconds, UE_SMALL_NUMBER);
+	Result.LogBufferBytes = Device.GetLogAllocatedSize();
+	Result.UsedPhysicalDelta = EndUsedPhysical - BaselineUsedPhysical;
+	Result.PeakUsedPhysicalDelta = FMath::Max(PeakUsedPhysical, EndUsedPhysical) - BaselineUsedPhysical;
+
+	TArray<uint64> AllCycles;
+	AllCycles.Reserve(Result.NumLines);
+	for (const TArray<uint64>& Cycles : ThreadCycles)
+	{
+		AllCycles.Append(Cycles);
+	}
+	AllCycles.Sort();
+
+	auto ToMicroseconds = [](uint64 Cycles)
+	{
+		return FPlatformTime::ToMilliseconds64(Cycles) * 1000.0;
+	};
+
+	Result.P50Microseconds = ToMicroseconds(AllCycles[AllCycles.Num() / 2]);
+	Result.P99Microseconds = ToMicroseconds(AllCycles[FMath::Min(static_cast<int32>(AllCycles.Num() * 0.99), AllCycles.Num() - 1)]);
+	Result.MaxMicroseconds = ToMicroseconds(AllCycles.Last());
+
+	return Result;
+}
+
+void FGDMOutputDeviceBenchmark::RunConsoleCommand(const TArray<FString>& Args)
+{
+	const int32 NumThreads = Args.IsValidIndex(0) ? FCString::Atoi(*Args[0]) : 4;
+	const int32 NumLinesPerThread = Args.IsValidIndex(1) ? FCString::Atoi(*Args[1]) : 100000;
+
+	const FResult Result = Run(NumThreads, NumLinesPerThread);
+
+	UE_LOG(LogGDM, Display, TEXT("GDM.BenchmarkOutputDevice: Threads %d Lines %d Time %.3fs"), Result.NumThreads, Result.NumLines, Result.TotalSeconds);
+	UE_LOG(LogGDM, Display, TEXT("GDM.BenchmarkOutputDevice: %.0f lines/sec  p50 %.2fus  p99 %.2fus  max %.2fus"), Result.LinesPerSecond, Result.P50Microseconds, Result.P99Microseconds, Result.MaxMicroseconds);
+	UE_LOG(LogGDM, Display, TEXT("GDM.BenchmarkOutputDevice: LogBuffer %.2fMB  UsedPhysical +%.2fMB (peak +%.2fMB)"), Result.LogBufferBytes / (1024.0 * 1024.0), Result.UsedPhysicalDelta / (1024.0 * 1024.0), Result.PeakUsedPhysicalDelta / (1024.0 * 1024.0));
+}
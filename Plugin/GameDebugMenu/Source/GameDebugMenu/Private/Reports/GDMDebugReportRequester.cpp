@@ -8,6 +8,7 @@
 #include "Reports/GDMDebugReportRequester.h"
 #include <GameDebugMenuManager.h>
 #include <GameDebugMenuFunctions.h>
+#include "GameDebugMenuSettings.h"
 #include "Kismet/GameplayStatics.h"
 
 const FString AGDMDebugReportRequester::LineBreak = TEXT("\r\n");
@@ -63,6 +64,21 @@ FString AGDMDebugReportRequester::GetDescription()
 	return PrefixDescriptionString() + Description + SuffixDescriptionString();
 }
 
+void AGDMDebugReportRequester::GetReportLogString(FString& OutLog)
+{
+	AGameDebugMenuManager* Manager = GetOwnerDebugMenuManager();
+	const float Duration = GetDefault<UGameDebugMenuSettings>()->ReportLogDurationSeconds;
+	if (Duration <= 0.0f)
+	{
+		Manager->GetOutputLogString(OutLog, LineBreak);
+		return;
+	}
+
+	/* 終端は現在までにしてレポート画面操作中のログも含める */
+	const double StartTime = Manager->GetShowDebugMenuTime() - Duration;
+	Manager->GetOutputLogStringInTimeRange(OutLog, LineBreak, StartTime, FPlatformTime::Seconds());
+}
+
 FString AGDMDebugReportRequester::PrefixSubjectString_Implementation()
 {
 	return FString();
@@ -54,7 +54,7 @@ void AGDMRequesterRedmine::RequestUploadLog()
 {
 	/* ゲーム内ログ */
 	FString GameLog;
-	GetOwnerDebugMenuManager()->GetOutputLogString(GameLog, LineBreak);
+	GetReportLogString(GameLog);
 
 	FString URL(TEXT("http://"));
 	URL += GetDefault<UGameDebugMenuSettings>()->RedmineSettings.HostName;
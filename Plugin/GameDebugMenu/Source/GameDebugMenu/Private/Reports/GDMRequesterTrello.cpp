@@ -99,7 +99,7 @@ void AGDMRequesterTrello::RequestUploadLog()
 
 	/* ゲーム内ログ */
 	FString GameLog;
-	GetOwnerDebugMenuManager()->GetOutputLogString(GameLog, LineBreak);
+	GetReportLogString(GameLog);
 	const FString DataName = FString::Printf(TEXT("name=\"file\";  filename=\"%s.txt\""), *UKismetSystemLibrary::GetGameName());
 	AddContentString(BoundaryKey, DataName, TEXT("text/plain; charset=UTF-8"), GameLog, ContentData);
 
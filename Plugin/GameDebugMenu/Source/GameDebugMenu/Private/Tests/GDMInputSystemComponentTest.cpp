@@ -0,0 +1,276 @@
+/**
+* Copyright (c) 2020 akihiko moroi
+*
+* This software is released under the MIT License.
+* (See accompanying file LICENSE.txt or copy at http://opensource.org/licenses/MIT)
+*/
+
+#include "CoreMinimal.h"
+#include "Components/InputComponent.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "Math/RandomStream.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/ScopeExit.h"
+
+#include "GameDebugMenuManager.h"
+#include "Input/GDMInputSystemComponent.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+	/**
+	 * UGDMInputSystemComponentと同じ規則で動く参照モデル
+	 */
+	struct FGDMInputGroupModel
+	{
+		/** グループ毎の登録順 */
+		TArray<TArray<UInputComponent*>> Orders;
+
+		/** グループ毎のアクティブなInputComponent */
+		TArray<TSet<UInputComponent*>> Actives;
+
+		/** GCされた扱いのInputComponent */
+		TSet<UInputComponent*> Dead;
+
+		int32 CurrentGroup = INDEX_NONE;
+		bool bMenuOpen = false;
+
+		explicit FGDMInputGroupModel(const int32 NumGroups)
+		{
+			Orders.SetNum(NumGroups);
+			Actives.SetNum(NumGroups);
+		}
+
+		void Register(UInputComponent* Input, const int32 Group)
+		{
+			if (Orders[Group].Contains(Input))
+			{
+				return;
+			}
+
+			Orders[Group].Add(Input);
+			if (Group == CurrentGroup && bMenuOpen)
+			{
+				Actives[Group].Add(Input);
+			}
+		}
+
+		void Unregister(UInputComponent* Input, const int32 Group)
+		{
+			Orders[Group].Remove(Input);
+			Actives[Group].Remove(Input);
+		}
+
+		void ActivateGroup(const int32 Group)
+		{
+			Orders[Group].RemoveAll([this](UInputComponent* Input) { return Dead.Contains(Input); });
+			Actives[Group] = TSet<UInputComponent*>(Orders[Group]);
+		}
+
+		void Switch(const int32 Group)
+		{
+			if (Group == CurrentGroup)
+			{
+				return;
+			}
+
+			if (CurrentGroup != INDEX_NONE)
+			{
+				Actives[CurrentGroup].Reset();
+			}
+
+			/* メニューの開閉に関わらず新しいグループはアクティブになる */
+			CurrentGroup = Group;
+			ActivateGroup(Group);
+		}
+
+		void Open()
+		{
+			if (bMenuOpen)
+			{
+				return;
+			}
+
+			bMenuOpen = true;
+			ActivateGroup(CurrentGroup);
+		}
+
+		void Close()
+		{
+			if (!bMenuOpen)
+			{
+				return;
+			}
+
+			bMenuOpen = false;
+			Actives[CurrentGroup].Reset();
+		}
+
+		UInputComponent* GetTop(const int32 Group) const
+		{
+			for (int32 Index = Orders[Group].Num() - 1; Index >= 0; --Index)
+			{
+				UInputComponent* Input = Orders[Group][Index];
+				if (!Dead.Contains(Input) && Actives[Group].Contains(Input))
+				{
+					return Input;
+				}
+			}
+			return nullptr;
+		}
+	};
+}
+
+/**
+ * InputComponentの登録/解除、グループ切り替え、メニュー開閉を繰り返して参照モデルと一致することを確認する
+ * (例: UnrealEditor-Cmd Project.uproject -nullrhi -ExecCmds="Automation RunTests GameDebugMenu.Input.InputGroupStack;Quit")
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGDMInputGroupStackTest, "GameDebugMenu.Input.InputGroupStack",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FGDMInputGroupStackTest::RunTest(const FString& Parameters)
+{
+	constexpr int32 NumGroups     = 4;
+	constexpr int32 NumComponents = 300;
+	constexpr int32 NumOperations = 4000;
+	constexpr int32 VerifyInterval = 100;
+
+	UWorld* World = UWorld::CreateWorld(EWorldType::Game, false, TEXT("GDMInputSystemComponentTestWorld"));
+	FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+	WorldContext.SetCurrentWorld(World);
+
+	ON_SCOPE_EXIT
+	{
+		GEngine->DestroyWorldContext(World);
+		World->DestroyWorld(false);
+	};
+
+	/* BeginPlayしないのでManagerの初期化（Widget生成など）は走らない */
+	APlayerController* PC = World->SpawnActor<APlayerController>();
+	if (!TestNotNull(TEXT("PlayerController"), PC))
+	{
+		return false;
+	}
+
+	FActorSpawnParameters SpawnInfo;
+	SpawnInfo.Owner = PC;
+	AGameDebugMenuManager* Manager = World->SpawnActor<AGameDebugMenuManager>(SpawnInfo);
+	if (!TestNotNull(TEXT("GameDebugMenuManager"), Manager))
+	{
+		return false;
+	}
+
+	UGDMInputSystemComponent* InputSystem = Manager->GetDebugMenuInputSystemComponent();
+	if (!TestNotNull(TEXT("InputSystemComponent"), InputSystem))
+	{
+		return false;
+	}
+
+	FName GroupNames[NumGroups];
+	for (int32 Group = 0; Group < NumGroups; ++Group)
+	{
+		GroupNames[Group] = *FString::Printf(TEXT("GDMTestGroup%d"), Group);
+	}
+
+	TArray<UInputComponent*> Inputs;
+	for (int32 Index = 0; Index < NumComponents; ++Index)
+	{
+		Inputs.Add(NewObject<UInputComponent>(PC));
+	}
+
+	FGDMInputGroupModel Model(NumGroups);
+	InputSystem->SwitchToInputGroup(GroupNames[0]);
+	Model.Switch(0);
+
+	auto Verify = [&](const int32 Step)
+	{
+		bool bMatched = true;
+		for (UInputComponent* Input : Inputs)
+		{
+			if (Model.Dead.Contains(Input))
+			{
+				continue;
+			}
+
+			const bool bExpected = Model.Actives[Model.CurrentGroup].Contains(Input);
+			if (InputSystem->IsInputComponentActive(Input) != bExpected || PC->IsInputComponentInStack(Input) != bExpected)
+			{
+				AddError(FString::Printf(TEXT("Step %d: %s is expected to be %s"), Step, *Input->GetName(), bExpected ? TEXT("active") : TEXT("inactive")));
+				bMatched = false;
+				break;
+			}
+		}
+
+		for (int32 Group = 0; Group < NumGroups; ++Group)
+		{
+			const UInputComponent* Expected = Model.GetTop(Group);
+			const UInputComponent* Actual = InputSystem->GetTopActiveInputComponent(GroupNames[Group]);
+			if (Actual != Expected)
+			{
+				AddError(FString::Printf(TEXT("Step %d: top of %s is %s (expected %s)"), Step, *GroupNames[Group].ToString(),
+					Actual ? *Actual->GetName() : TEXT("null"), Expected ? *Expected->GetName() : TEXT("null")));
+				bMatched = false;
+			}
+		}
+		return bMatched;
+	};
+
+	FRandomStream Random(0x6D4);
+	for (int32 Step = 0; Step < NumOperations; ++Step)
+	{
+		const int32 Operation = Random.RandRange(0, 99);
+		const int32 Group = Random.RandRange(0, NumGroups - 1);
+		UInputComponent* Input = Inputs[Random.RandRange(0, NumComponents - 1)];
+		const bool bAlive = !Model.Dead.Contains(Input);
+
+		if (Operation < 45)
+		{
+			if (bAlive)
+			{
+				InputSystem->RegisterInputComponentToGroup(Input, GroupNames[Group]);
+				Model.Register(Input, Group);
+			}
+		}
+		else if (Operation < 75)
+		{
+			if (bAlive)
+			{
+				InputSystem->UnregisterInputComponentFromGroup(Input, GroupNames[Group]);
+				Model.Unregister(Input, Group);
+			}
+		}
+		else if (Operation < 85)
+		{
+			InputSystem->SwitchToInputGroup(GroupNames[Group]);
+			Model.Switch(Group);
+		}
+		else if (Operation < 92)
+		{
+			InputSystem->OnOpenMenu();
+			Model.Open();
+		}
+		else if (Operation < 98)
+		{
+			InputSystem->OnCloseMenu();
+			Model.Close();
+		}
+		else if (bAlive)
+		{
+			/* 登録解除せずにGCされたケース */
+			Input->MarkAsGarbage();
+			Model.Dead.Add(Input);
+		}
+
+		if ((Step % VerifyInterval) == 0 && !Verify(Step))
+		{
+			return false;
+		}
+	}
+
+	return Verify(NumOperations);
+}
+
+#endif
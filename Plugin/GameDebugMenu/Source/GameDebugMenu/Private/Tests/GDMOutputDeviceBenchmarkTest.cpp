@@ -0,0 +1,100 @@
+/**
+* Copyright (c) 2020 akihiko moroi
+*
+* This software is released under the MIT License.
+* (See accompanying file LICENSE.txt or copy at http://opensource.org/licenses/MIT)
+*/
+
+#include "CoreMinimal.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/AutomationTest.h"
+
+#include "Log/GDMOutputDeviceBenchmark.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+	TAutoConsoleVariable<int32> CVarGDMBenchmarkLinesPerThread(
+		TEXT("GDM.Benchmark.LinesPerThread"),
+		100000,
+		TEXT("GameDebugMenu.Log.OutputDeviceBenchmark: number of lines each thread writes."),
+		ECVF_Default);
+
+	TAutoConsoleVariable<float> CVarGDMBenchmarkMinLinesPerSecond(
+		TEXT("GDM.Benchmark.MinLinesPerSecond"),
+		100000.0f,
+		TEXT("GameDebugMenu.Log.OutputDeviceBenchmark fails below this throughput (all threads). 0 disables the check."),
+		ECVF_Default);
+
+	TAutoConsoleVariable<float> CVarGDMBenchmarkMaxP99Microseconds(
+		TEXT("GDM.Benchmark.MaxP99Microseconds"),
+		200.0f,
+		TEXT("GameDebugMenu.Log.OutputDeviceBenchmark fails when the p99 Serialize latency exceeds this. 0 disables the check."),
+		ECVF_Default);
+
+	TAutoConsoleVariable<float> CVarGDMBenchmarkMaxBytesPerLine(
+		TEXT("GDM.Benchmark.MaxBytesPerLine"),
+		512.0f,
+		TEXT("GameDebugMenu.Log.OutputDeviceBenchmark fails when the log buffer exceeds this many bytes per captured line. 0 disables the check."),
+		ECVF_Default);
+}
+
+/**
+ * FGDMOutputDevice::Serializeを複数スレッドから呼び、1行あたりの取り込みコストを計測する
+ * (例: UnrealEditor-Cmd Project.uproject -nullrhi -ExecCmds="Automation RunTests GameDebugMenu.Log.OutputDeviceBenchmark;Quit")
+ * 閾値は GDM.Benchmark.* のコンソール変数で変更できる
+ */
+IMPLEMENT_COMPLEX_AUTOMATION_TEST(FGDMOutputDeviceBenchmarkTest, "GameDebugMenu.Log.OutputDeviceBenchmark",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+void FGDMOutputDeviceBenchmarkTest::GetTests(TArray<FString>& OutBeautifiedNames, TArray<FString>& OutTestCommands) const
+{
+	for (const int32 NumThreads : { 1, 4, 8 })
+	{
+		OutBeautifiedNames.Add(FString::Printf(TEXT("Threads%d"), NumThreads));
+		OutTestCommands.Add(FString::FromInt(NumThreads));
+	}
+}
+
+bool FGDMOutputDeviceBenchmarkTest::RunTest(const FString& Parameters)
+{
+	const int32 NumThreads = FCString::Atoi(*Parameters);
+	const FGDMOutputDeviceBenchmark::FResult Result = FGDMOutputDeviceBenchmark::Run(NumThreads, CVarGDMBenchmarkLinesPerThread.GetValueOnAnyThread());
+
+	const double BytesPerLine = static_cast<double>(Result.LogBufferBytes) / FMath::Max(Result.NumLines, 1);
+
+	AddInfo(FString::Printf(TEXT("Threads %d Lines %d Time %.3fs"), Result.NumThreads, Result.NumLines, Result.TotalSeconds));
+	AddInfo(FString::Printf(TEXT("%.0f lines/sec  p50 %.2fus  p99 %.2fus  max %.2fus"), Result.LinesPerSecond, Result.P50Microseconds, Result.P99Microseconds, Result.MaxMicroseconds));
+	AddInfo(FString::Printf(TEXT("LogBuffer %.2fMB (%.1f bytes/line)  UsedPhysical +%.2fMB (peak +%.2fMB)"), Result.LogBufferBytes / (1024.0 * 1024.0), BytesPerLine, Result.UsedPhysicalDelta / (1024.0 * 1024.0), Result.PeakUsedPhysicalDelta / (1024.0 * 1024.0)));
+
+	AddTelemetryData(TEXT("LinesPerSecond"), Result.LinesPerSecond, Parameters);
+	AddTelemetryData(TEXT("P50Microseconds"), Result.P50Microseconds, Parameters);
+	AddTelemetryData(TEXT("P99Microseconds"), Result.P99Microseconds, Parameters);
+	AddTelemetryData(TEXT("MaxMicroseconds"), Result.MaxMicroseconds, Parameters);
+	AddTelemetryData(TEXT("LogBufferBytes"), static_cast<double>(Result.LogBufferBytes), Parameters);
+	AddTelemetryData(TEXT("UsedPhysicalDeltaBytes"), static_cast<double>(Result.UsedPhysicalDelta), Parameters);
+	AddTelemetryData(TEXT("PeakUsedPhysicalDeltaBytes"), static_cast<double>(Result.PeakUsedPhysicalDelta), Parameters);
+
+	const float MinLinesPerSecond = CVarGDMBenchmarkMinLinesPerSecond.GetValueOnAnyThread();
+	if (MinLinesPerSecond > 0.0f && Result.LinesPerSecond < MinLinesPerSecond)
+	{
+		AddError(FString::Printf(TEXT("Throughput %.0f lines/sec is below GDM.Benchmark.MinLinesPerSecond (%.0f)"), Result.LinesPerSecond, MinLinesPerSecond));
+	}
+
+	const float MaxP99Microseconds = CVarGDMBenchmarkMaxP99Microseconds.GetValueOnAnyThread();
+	if (MaxP99Microseconds > 0.0f && Result.P99Microseconds > MaxP99Microseconds)
+	{
+		AddError(FString::Printf(TEXT("p99 %.2fus exceeds GDM.Benchmark.MaxP99Microseconds (%.2fus)"), Result.P99Microseconds, MaxP99Microseconds));
+	}
+
+	const float MaxBytesPerLine = CVarGDMBenchmarkMaxBytesPerLine.GetValueOnAnyThread();
+	if (MaxBytesPerLine > 0.0f && BytesPerLine > MaxBytesPerLine)
+	{
+		AddError(FString::Printf(TEXT("Log buffer uses %.1f bytes/line, above GDM.Benchmark.MaxBytesPerLine (%.1f)"), BytesPerLine, MaxBytesPerLine));
+	}
+
+	return !HasAnyErrors();
+}
+
+#endif
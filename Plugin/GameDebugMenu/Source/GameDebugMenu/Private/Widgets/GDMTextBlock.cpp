@@ -22,6 +22,8 @@ UGDMTextBlock::UGDMTextBlock(const FObjectInitializer& ObjectInitializer)
 #if WITH_EDITORONLY_DATA
 	, PreviewLanguageKey(TEXT("Japanese"))
 #endif
+	, RegisteredManager(nullptr)
+	, RegisteredIndex(INDEX_NONE)
 {
 	if( !IsRunningDedicatedServer() )
 	{
@@ -103,6 +105,64 @@ void UGDMTextBlock::SetText(FText InText)
 	Super::SetText(InText);
 }
 
+void UGDMTextBlock::ReleaseSlateResources(bool bReleaseChildren)
+{
+	Super::ReleaseSlateResources(bReleaseChildren);
+
+	UnregisterFromDebugMenuManager();
+}
+
+void UGDMTextBlock::BeginDestroy()
+{
+	UnregisterFromDebugMenuManager();
+
+	Super::BeginDestroy();
+}
+
+void UGDMTextBlock::SetResolvedDebugMenuString(const FString& DebugMenuString)
+{
+	Super::SetText(FText::FromString(DebugMenuString));
+}
+
+TSharedRef<SWidget> UGDMTextBlock::RebuildWidget()
+{
+	TSharedRef<SWidget> Widget = Super::RebuildWidget();
+
+	RegisterToDebugMenuManager();
+
+	return Widget;
+}
+
+void UGDMTextBlock::RegisterToDebugMenuManager()
+{
+	if( IsDesignTime() || RegisteredManager.IsValid() )
+	{
+		return;
+	}
+
+	UWorld* World = GetWorld();
+	if( !IsValid(World) || !World->IsGameWorld() )
+	{
+		return;
+	}
+
+	if( AGameDebugMenuManager* Manager = UGameDebugMenuFunctions::GetGameDebugMenuManager(World, false) )
+	{
+		Manager->RegisterDebugMenuTextBlock(this);
+	}
+}
+
+void UGDMTextBlock::UnregisterFromDebugMenuManager()
+{
+	if( AGameDebugMenuManager* Manager = RegisteredManager.GetEvenIfUnreachable() )
+	{
+		Manager->UnregisterDebugMenuTextBlock(this);
+	}
+
+	RegisteredManager.Reset();
+	RegisteredIndex = INDEX_NONE;
+}
+
 void UGDMTextBlock::SetWrapTextAt(float InWrapTextAt)
 {
 	WrapTextAt = InWrapTextAt;
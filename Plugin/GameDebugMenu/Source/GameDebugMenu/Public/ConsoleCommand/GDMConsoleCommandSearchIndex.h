@@ -0,0 +1,86 @@
+/**
+* Copyright (c) 2020 akihiko moroi
+*
+* This software is released under the MIT License.
+* (See accompanying file LICENSE.txt or copy at http://opensource.org/licenses/MIT)
+*/
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameDebugMenuTypes.h"
+
+class UGDMConsoleCommandSetAsset;
+
+/**
+ * コンソールコマンドの検索用インデックス
+ * タイトル、コマンド、カテゴリ、説明の単語をプレフィックストライに、各文字列をトライグラムに登録し
+ * 前方一致、部分一致、あいまい一致でスコアを付けて上位の結果を返す
+ */
+class GAMEDEBUGMENU_API FGDMConsoleCommandSearchIndex
+{
+public:
+	/** 検索対象の項目 */
+	enum EField : uint8
+	{
+		Field_Title,
+		Field_Command,
+		Field_Category,
+		Field_Description,
+		Field_Num,
+	};
+
+private:
+	struct FEntry
+	{
+		EGDMConsoleCommandType Type;
+		int32 ArrayIndex;
+
+		/** 小文字化済み */
+		FString Fields[Field_Num];
+	};
+
+	struct FTrieNode
+	{
+		TMap<TCHAR, int32> Children;
+
+		/** この接頭辞を持つ単語がある (Entry << 2 | Field) の一覧 */
+		TArray<uint32> Postings;
+	};
+
+	TArray<FEntry> Entries;
+	TArray<FTrieNode> TrieNodes;
+
+	/** トライグラム -> Entry一覧（昇順・重複なし） */
+	TMap<uint64, TArray<int32>> TrigramPostings;
+
+	bool bBuilt = false;
+
+	/** 作成時のテキストのリビジョン（FText::ToStringで取り込むので言語が切り替わったら作り直す） */
+	uint16 BuiltTextRevision = 0;
+
+	/** 前回の検索文字列と一致したEntry。追加入力時はここから絞り込む（あいまい一致する語がない場合のみ） */
+	FString LastQuery;
+	TBitArray<> LastMatches;
+
+public:
+	void Build(const UGDMConsoleCommandSetAsset& Asset);
+	void Reset();
+	bool IsBuilt() const { return bBuilt; }
+
+	/** 作成済みかつ作成後に言語が切り替わっていないか */
+	bool IsUpToDate() const;
+	int32 Num() const { return Entries.Num(); }
+
+	/**
+	 * 空白区切りの全ての語に一致するコマンドをスコア順に最大MaxResults件返す
+	 */
+	void Search(const FString& Query, int32 MaxResults, TArray<FGDMConsoleCommandSearchResult>& OutResults);
+
+private:
+	void AddEntry(EGDMConsoleCommandType Type, int32 ArrayIndex, const FString& Title, const FString& Command, const FString& Category, const FString& Description);
+	void AddWord(const TCHAR* Word, int32 Len, uint32 Posting);
+	void AddTrigrams(const FString& Text, int32 EntryIndex);
+	void ScoreToken(const FString& Token, const TBitArray<>& Candidates, TArray<float>& OutTokenScores) const;
+	static bool CanFuzzyMatch(const FString& Token);
+};
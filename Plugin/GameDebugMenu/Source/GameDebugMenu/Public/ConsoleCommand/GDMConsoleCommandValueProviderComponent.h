@@ -47,10 +47,37 @@ protected:
 
 	UPROPERTY(EditAnywhere, Instanced, Category="GDM")
 	TObjectPtr<UGDMConsoleVariableCommandValueProvider> ConsoleVariableCommandValueProvider;
+
+private:
+	/** ProviderPatternsを小文字で登録したトライ木。一致したパターンの最小Indexを持つ */
+	struct FPatternNode
+	{
+		TMap<TCHAR, int32> Children;
+		int32 PatternIndex = INDEX_NONE;
+	};
+
+	TArray<FPatternNode> PatternNodes;
+	bool bPatternsCompiled = false;
+
+	/** コマンド名 -> 一致したProviderPatternsのIndex（INDEX_NONEはfallback） */
+	TMap<FString, int32> ResolvedPatternIndices;
 	
 public:
 	UGDMConsoleCommandValueProviderComponent();
 
+#if WITH_EDITOR
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+
 	UFUNCTION(BlueprintCallable, Category = "Console")
 	bool GetFloatValue(const FString& CommandName, float& OutValue);
+
+	/**
+	 * パターンの照合結果を破棄する（ProviderPatternsを変更したら呼ぶ）
+	 */
+	void InvalidatePatterns();
+
+private:
+	void CompilePatterns();
+	int32 MatchPattern(const FString& CommandName);
 };
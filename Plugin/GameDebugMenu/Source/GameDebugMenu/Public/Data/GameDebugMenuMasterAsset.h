@@ -49,13 +49,24 @@ public:
 	UPROPERTY(EditAnywhere, Category = "Font", meta = (AllowedClasses = "/Script/Engine.Font", DisplayName = "Font Family"))
 	FSoftObjectPath FontName;
 
+private:
+	/** DebugMenuManagerClassesのクラス名（_Cを除く） -> インデックス。初回の検索時に作成 */
+	mutable TMap<FString, int32> ManagerClassIndices;
+	mutable bool bManagerClassIndicesBuilt;
+
 public:
 	UGameDebugMenuMasterAsset(const FObjectInitializer& ObjectInitializer);
 	virtual FPrimaryAssetId GetPrimaryAssetId() const override;
+#if WITH_EDITOR
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
 
 	static const FPrimaryAssetType& GetPrimaryType();
 
 
 	TSoftClassPtr<AGameDebugMenuManager> GetGameDebugMenuManagerSoftClass(FString ClassName) const;
+
+private:
+	void BuildManagerClassIndices() const;
 };
 
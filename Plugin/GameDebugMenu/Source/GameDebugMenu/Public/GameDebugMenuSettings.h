@@ -20,6 +20,40 @@ class IGDMDeveloperSettingProvider;
 class AGDMDebugReportRequester;
 class UGDMEnhancedInputComponent;
 
+/**
+* プラグイン既定のコンソールコマンド一覧
+*/
+struct GAMEDEBUGMENU_API FGDMConsoleCommandCatalog
+{
+	TArray<FGDMConsoleCommandSingle> ConsoleCommandNames;
+	TArray<FGDMConsoleCommandGroup> ConsoleCommandGroups;
+	TArray<FGDMConsoleCommandPair> ConsoleCommandPairs;
+	TArray<FGDMConsoleCommandNumber> ConsoleCommandNumbers;
+	TArray<FGDMConsoleCommandSingle> EditorOnlyConsoleCommandNames;
+	TArray<FGDMConsoleCommandGroup> EditorOnlyConsoleCommandGroups;
+	TArray<FGDMConsoleCommandPair> EditorOnlyConsoleCommandPairs;
+	TArray<FGDMConsoleCommandNumber> EditorOnlyConsoleCommandNumbers;
+
+	static FGDMConsoleCommandCatalog CreateDefault();
+
+private:
+	void SetupCategoryResets();
+	void SetupCategorySlomo();
+	void SetupCategoryCamera();
+	void SetupCategoryProfiler();
+	void SetupCategoryDisplay();
+	void SetupCategoryShowDebug();
+	void SetupCategoryViewMode();
+	void SetupCategoryScalability();
+	void SetupCategoryFreeze();
+	void SetupCategoryDumpLogs();
+	void SetupCategoryNetwork();
+	void SetupCategorySound();
+	void SetupCategoryAbilitySystem();
+	void SetupCategoryOther();
+	void SetupCategoryLogVerbosity();
+};
+
 /**
 * DebugMenu用設定クラス
 */
@@ -33,7 +67,7 @@ public:
 	UPROPERTY(EditAnywhere, config, Category = "Meta")
 	FString MasterAssetName;
 	
-	/** コンソールコマンド名 */
+	/** コンソールコマンド名（ConsoleCommand系はINIで設定されていない配列ごとにプラグイン既定のコマンドを使用） */
 	UPROPERTY(EditAnywhere, config, Category = "ConsoleCommand")
 	TArray<FGDMConsoleCommandSingle> ConsoleCommandNames;
 	
@@ -69,6 +103,10 @@ public:
 	UPROPERTY(EditAnywhere, config, Category = "ConsoleCommand")
 	TArray<FGDMOrderMenuCategoryTitle> OrderConsoleCommandCategoryTitles;
 
+	/** 複数のコンソールコマンドをまとめて実行するときの1フレームあたりの実行時間の目安。0なら1フレームで全て実行する */
+	UPROPERTY(EditAnywhere, config, Category = "ConsoleCommand", meta = (ClampMin = "0.0", Units = "ms"))
+	float ConsoleCommandFrameBudgetMs;
+
 	/** Gameplayメニューのカテゴリ名表示順(最大255) */
 	UPROPERTY(EditAnywhere, config, Category = "Gameplay")
 	TArray<FGDMOrderMenuCategoryTitle> OrderGameplayCategoryTitles;
@@ -97,6 +135,14 @@ public:
 	UPROPERTY(EditAnywhere, Category = "ReportSettings")
 	bool bDisableScreenCaptureProcessingWhenOpeningDebugMenu;
 
+	/** バグレポートに添付するログの範囲（メニューを開く何秒前から）。0以下ならすべてのログを添付する */
+	UPROPERTY(EditAnywhere, config, Category = "ReportSettings", meta = (ClampMin = "0.0", Units = "s"))
+	float ReportLogDurationSeconds;
+
+	/** True: 連続した同じログを1行にまとめて回数を付与する（ログ保持のメモリ節約） */
+	UPROPERTY(EditAnywhere, config, Category = "ReportSettings")
+	bool bCollapseRepeatedLogLines;
+
 	/** DebugMenuから指定できるCultureのリスト */
 	UPROPERTY(EditAnywhere, config, Category = "Localization")
 	TArray<FString> CultureList;
@@ -141,6 +187,9 @@ private:
 	UPROPERTY(transient)
 	mutable TObjectPtr<UGameDebugMenuMasterAsset> MasterAsset;
 
+	/** True: INIで設定されていないConsoleCommand系の配列へ既定のコマンドをセット済み */
+	bool bAppliedDefaultConsoleCommands;
+
 public:
 	UGameDebugMenuSettings();
 
@@ -166,22 +215,27 @@ public:
 	UObject* GetDebugMenuFont() const;
 
 	UGameDebugMenuMasterAsset* GetMasterAsset() const;
-	
-private:
-	void SetupCategoryResets();
-	void SetupCategorySlomo();
-	void SetupCategoryCamera();
-	void SetupCategoryProfiler();
-	void SetupCategoryDisplay();
-	void SetupCategoryShowDebug();
-	void SetupCategoryViewMode();
-	void SetupCategoryScalability();
-	void SetupCategoryFreeze();
-	void SetupCategoryDumpLogs();
-	void SetupCategoryNetwork();
-	void SetupCategorySound();
-	void SetupCategoryAbilitySystem();
-	void SetupCategoryOther();
-	void SetupCategoryLogVerbosity();
 
+	/**
+	 * 指定したプロパティがINIファイルで設定されているか
+	 */
+	bool IsPropertySetInConfig(const FName& PropertyName) const;
+
+	/**
+	 * INIファイルで設定されていないConsoleCommand系の配列にプラグイン既定のコマンドをセットする（CDOに対して一度だけ行う）
+	 * 起動時には行わず、コマンド一覧を作る時やProject Settingsを開いた時に呼ぶ
+	 * @return true: この呼び出しでセットした
+	 */
+	bool ApplyDefaultConsoleCommandsToUnsetArrays();
+
+	/**
+	 * プラグイン既定のコンソールコマンド一覧を取得（初回呼び出し時に作成）
+	 */
+	static const FGDMConsoleCommandCatalog& GetDefaultConsoleCommandCatalog();
+
+	/**
+	 * プラグイン既定のコンソールコマンド一覧をこの設定に書き込む
+	 */
+	UFUNCTION(CallInEditor, Category = "ConsoleCommand")
+	void ResetToDefaultConsoleCommands();
 };
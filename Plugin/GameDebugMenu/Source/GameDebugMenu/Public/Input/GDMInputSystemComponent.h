@@ -8,6 +8,7 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "UObject/ObjectKey.h"
 #include "Data/GameDebugMenuManagerAsset.h"
 #include "GDMInputSystemComponent.generated.h"
 
@@ -32,11 +33,45 @@ protected:
 	UPROPERTY(Transient)
 	TObjectPtr<AGDMDebugCameraInput> DebugCameraInput;
 
-	/** 登録中のInputComponent郡 */
-	TMap<FName, TArray<TWeakObjectPtr<UInputComponent>>> RegisteredInputGroups;
+	/** 登録中のInputComponent（グループ毎に登録順の双方向リストで繋ぐ） */
+	struct FInputEntry
+	{
+		TWeakObjectPtr<UInputComponent> InputComponent;
 
-	/** 利用中のInputComponent郡 */
-	TMap<FName, TArray<TWeakObjectPtr<UInputComponent>>> ActiveInputStacks;
+		/** InputEntryIndicesのキー（GC後でも解除できるように保持） */
+		TObjectKey<UInputComponent> InputComponentKey;
+		int32 GroupIndex = INDEX_NONE;
+		int32 PrevIndex = INDEX_NONE;
+		int32 NextIndex = INDEX_NONE;
+
+		/** グループ内のアクティブなEntryをアクティブにした順で繋ぐ */
+		int32 ActivePrevIndex = INDEX_NONE;
+		int32 ActiveNextIndex = INDEX_NONE;
+
+		/** PlayerControllerに追加済みか */
+		bool bActive = false;
+	};
+
+	/** InputComponentのグループ */
+	struct FInputGroup
+	{
+		FName GroupName;
+		int32 HeadIndex = INDEX_NONE;
+		int32 TailIndex = INDEX_NONE;
+
+		/** 最後にPlayerControllerへ追加されたEntry（アクティブなリストの末尾） */
+		int32 TopActiveIndex = INDEX_NONE;
+	};
+
+	/** 登録中のInputComponent郡。インデックスは解除されるまで変わらない */
+	TSparseArray<FInputEntry> InputEntries;
+
+	/** (InputComponent, グループ) -> InputEntriesのインデックス */
+	TMap<TPair<TObjectKey<UInputComponent>, int32>, int32> InputEntryIndices;
+
+	/** グループは削除しないのでインデックスは固定 */
+	TArray<FInputGroup> InputGroups;
+	TMap<FName, int32> InputGroupIndices;
 
 	/** 現在アクティブなInputComponentのグループ名 */
 	FName CurrentInputGroupName;
@@ -61,10 +96,22 @@ protected:
 	FDelegateHandle ActorSpawnedDelegateHandle;
 
 	TWeakObjectPtr<ADebugCameraController> DebugCameraController;
+
+	/** 入力判定用ログの表示文字列。スタックや言語が変わった時だけ作り直す */
+	FString CachedDebugLogText;
+
+	/** CachedDebugLogTextを作成した時の言語 */
+	FName CachedDebugLogLanguage;
+
+	/** CachedDebugLogTextに表示しているInputComponent（破棄されたら作り直す） */
+	TArray<TWeakObjectPtr<const UInputComponent>> CachedDebugLogInputComponents;
+
+	/** CachedDebugLogTextの作り直しが必要か */
+	bool bDebugLogTextDirty;
 	
 public:
-	/** 入力判定用ログ */
-	UPROPERTY(BlueprintReadWrite, Category = "GDM|Debug")
+	/** 入力判定用ログ（有効な間だけTickする） */
+	UPROPERTY(BlueprintReadWrite, BlueprintSetter = SetOutputDebugLog, Category = "GDM|Debug")
 	bool bOutputDebugLog;
 
 public:	
@@ -77,6 +124,12 @@ public:
 	virtual void ResetIgnoreInput();
 	virtual bool IsInputIgnored() const;
 
+	/**
+	 * 入力判定用ログの表示切替
+	 */
+	UFUNCTION(BlueprintSetter)
+	void SetOutputDebugLog(bool bNewOutputDebugLog);
+
 	/**
 	 * 初期化
 	 */
@@ -100,6 +153,16 @@ public:
 	*/
 	virtual void SwitchToInputGroup(const FName NewGroupName);
 
+	/**
+	 * InputComponentが現在のグループでPlayerControllerに追加されているか
+	 */
+	bool IsInputComponentActive(const UInputComponent* InputComponent) const;
+
+	/**
+	 * 指定したグループで最後にPlayerControllerへ追加されたInputComponentを返す
+	 */
+	UInputComponent* GetTopActiveInputComponent(const FName GroupName) const;
+
 	/**
 	 * デバックメニューが開くと呼ばれる
 	 * @note アクティブなメニューのInputComponentをPlayerControllerに追加する
@@ -115,6 +178,17 @@ public:
 protected:
 	virtual void CreateDebugCameraInputClass(TSubclassOf<AGDMDebugCameraInput> DebugCameraInputClass);
 	AGameDebugMenuManager* GetOwnerGameDebugMenuManager() const;
-	TArray<APlayerController*> GetPlayerControllers() const;
+	TArray<APlayerController*, TInlineAllocator<2>> GetPlayerControllers() const;
 	virtual void OnActorSpawned(AActor* SpawnActor);
+	void RebuildDebugLogText();
+
+	int32 FindOrAddInputGroup(const FName GroupName);
+	int32 FindInputEntry(const UInputComponent* InputComponent, const int32 GroupIndex) const;
+	void RemoveInputEntry(const int32 EntryIndex);
+	void ActivateInputEntry(const int32 EntryIndex);
+	void DeactivateInputEntry(const int32 EntryIndex);
+
+	/** グループ内の全Entryをアクティブにする（無効になったEntryはここで取り除く） */
+	void ActivateInputGroup(const int32 GroupIndex);
+	void DeactivateInputGroup(const int32 GroupIndex, TConstArrayView<APlayerController*> PCs);
 };
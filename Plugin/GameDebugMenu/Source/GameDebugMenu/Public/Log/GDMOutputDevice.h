@@ -14,6 +14,69 @@
 
 class AGameDebugMenuManager;
 
+typedef TSharedRef<TArray<TCHAR>, ESPMode::ThreadSafe> FGDMLogTextChunkRef;
+
+DECLARE_DELEGATE_OneParam(FGDMOnLogExportProgress, float /* Progress */);
+DECLARE_DELEGATE_TwoParams(FGDMOnLogExportCompleted, bool /* bSuccess */, const FString& /* FilePath */);
+
+/**
+ * NoSaveConsoleCommandsの判定用トライ木
+ * 登録文字列を小文字で木にしておき、コマンド文字列の各位置から辿って部分一致を判定する（登録件数に依存しない）
+ */
+struct GAMEDEBUGMENU_API FGDMCommandFilterTrie
+{
+	struct FNode
+	{
+		TMap<TCHAR, int32> Children;
+		bool bTerminal = false;
+	};
+
+	TArray<FNode> Nodes;
+
+	void Build(const TArray<FString>& Patterns);
+	bool ContainsAny(const FString& Str) const;
+};
+
+/**
+ * 取り込んだログ1行毎の記録時間（FPlatformTime::Seconds）とフレーム番号
+ */
+struct FGDMLogLineStamp
+{
+	double Time;
+	uint64 Frame;
+};
+
+/**
+ * 取り込んだログ1行の情報。本文はチャンク内の位置のみ持ち、行頭の書式はカテゴリ等から取得時に組み立てる
+ */
+struct FGDMLogLine
+{
+	/** メッセージ先頭行のみ有効 */
+	FName Category;
+	int32 ChunkIndex;
+	int32 Offset;
+	uint16 Len;
+	uint8 Verbosity;
+	uint8 bFirstLineInMessage : 1;
+
+	/** 連続した同一行をまとめた回数 */
+	int32 RepeatCount;
+};
+
+/**
+ * 書き出し用に複製したログ。埋まったチャンクは書き換わらないので共有し、書き込み中のチャンクだけ複製する
+ */
+struct GAMEDEBUGMENU_API FGDMLogSnapshot
+{
+	TArray<FGDMLogTextChunkRef> TextChunks;
+	TArray<FGDMLogLine> Lines;
+	TArray<FGDMLogLineStamp> Stamps;
+	FDateTime CaptureStartUtc;
+	double CaptureStartTime = 0.0;
+
+	FString FormatLogLine(int32 Index) const;
+};
+
 /**
  * DebugMenuで使用できるようにするOutputLogの文字情報
  * プロジェクト名.log取得したかったけど起動中はアクセスできないため文字列情報はこれから取得。
@@ -21,18 +84,106 @@ class AGameDebugMenuManager;
  */
 class GAMEDEBUGMENU_API FGDMOutputDevice : public FOutputDevice
 {
-	TArray<FString> Logs;
-	TArray<FString> CommandHistory;
+	/** 古い順の双方向リストで繋ぐコマンド履歴 */
+	struct FCommandHistoryEntry
+	{
+		FString Command;
+		int32 PrevIndex = INDEX_NONE;
+		int32 NextIndex = INDEX_NONE;
+	};
+
+	/** ログ本文を詰めて保持する固定長チャンク（行毎にFStringを確保しない） */
+	TArray<FGDMLogTextChunkRef> LogTextChunks;
+	TArray<FGDMLogLine> LogLines;
+
+	/** LogLinesと同じ並びの記録時間。取り込み順に単調増加なので二分探索で範囲を引ける */
+	TArray<FGDMLogLineStamp> LogStamps;
+
+	/** まとめた行の最後に出力された時間（LogStampsは最初に出力された時間のまま） */
+	TMap<int32, FGDMLogLineStamp> LastRepeatStamps;
+	mutable FCriticalSection LogsMutex;
+
+	/** 記録時間からUTCを復元するための基準 */
+	FDateTime CaptureStartUtc;
+	double CaptureStartTime;
+
+	/** True: 連続した同一行を1行にまとめる */
+	bool bCollapseRepeatedLines;
+
+	/** 確保済みチャンクのサイズ合計（チャンクの追加時のみ更新する） */
+	SIZE_T LogTextChunkBytes;
+
+	/** STAT_GDMLogBufferMemoryへ計上済みのサイズ */
+	SIZE_T ReportedLogMemory;
+
+	/** True: GLogに登録している */
+	bool bRegisteredToLog;
+
+	/** コマンド履歴（MaxCommandHistoryNum固定長）。埋まったら一番古いEntryを使い回す */
+	TArray<FCommandHistoryEntry> CommandHistory;
+	int32 OldestCommandHistoryIndex;
+	int32 NewestCommandHistoryIndex;
+	int32 CommandHistoryNum;
+
+	/** コマンド -> CommandHistoryのインデックス。同じコマンドは枠を増やさず最新へ移す */
+	TMap<FString, int32> CommandHistoryIndices;
+
+	/** 保存しないコマンドの判定用 */
+	FGDMCommandFilterTrie NoSaveCommandFilter;
+
 	mutable FCriticalSection CommandHistoryMutex;
+
+#if WITH_EDITOR
+	FDelegateHandle SettingsChangedHandle;
+	void OnSettingsChanged(UObject* Settings, struct FPropertyChangedEvent& PropertyChangedEvent);
+#endif
+
+	void AddCommandHistory(const TCHAR* Command);
+
+	/** 以下 CommandHistoryMutexロック中に呼ぶこと */
+	void LinkNewestCommandHistory(const int32 Index);
+	void UnlinkCommandHistory(const int32 Index);
+
+	/** MaxCommandHistoryNumとNoSaveConsoleCommandsを設定から読み直す（CommandHistoryMutexロック中に呼ぶこと） */
+	void ApplyCommandHistorySettings();
+
+	/** 以下 LogsMutexロック中に呼ぶこと */
+	void AddLogLine(const TCHAR* Text, int32 Len, const FName& Category, ELogVerbosity::Type Verbosity, bool bFirstLineInMessage, const FGDMLogLineStamp& Stamp);
+	bool TryCollapseLogLine(const TCHAR* Text, int32 Len, const FName& Category, ELogVerbosity::Type Verbosity, const FGDMLogLineStamp& Stamp);
+	FString FormatLogLine(int32 Index) const;
+	int32 IncludeRepeatedLogLine(int32 First, double StartTime, uint64 StartFrame, bool bByFrame) const;
+	TArray<FString> CopyLogs(int32 First, int32 Last) const;
+	void UpdateLogMemoryStat();
 	
 public:
-	FGDMOutputDevice();
+	explicit FGDMOutputDevice(bool bRegisterToLog = true);
 	virtual ~FGDMOutputDevice() override;
+	virtual bool CanBeUsedOnMultipleThreads() const override { return true; }
 	virtual void Serialize(const TCHAR* Data, ELogVerbosity::Type Verbosity, const class FName& Category, const double Time) override;
 	virtual void Serialize(const TCHAR* Data, ELogVerbosity::Type Verbosity, const class FName& Category) override;
 
 public:
 	TArray<FString> GetLogs() const;
+
+	/** 記録時間（FPlatformTime::Seconds）が [StartTime, EndTime] のログを取得 */
+	TArray<FString> GetLogsInTimeRange(double StartTime, double EndTime) const;
+
+	/** 記録フレーム（GFrameCounter）が [StartFrame, EndFrame] のログを取得 */
+	TArray<FString> GetLogsInFrameRange(uint64 StartFrame, uint64 EndFrame) const;
+
+	/** ログ保持に使用しているメモリサイズ */
+	SIZE_T GetLogAllocatedSize() const;
+
+	/** 現在のログを複製（重い整形や書き出しはこれを使ってワーカースレッドで行う） */
+	TSharedRef<FGDMLogSnapshot, ESPMode::ThreadSafe> CreateSnapshot() const;
+
+	/**
+	 * 現在のログをワーカースレッドでファイルに書き出す（ゲームスレッドは複製のみ行う）
+	 * @param bCompress true: gzipで圧縮して書き出す
+	 * 進捗と完了はゲームスレッドで通知される
+	 */
+	void ExportLogsAsync(const FString& FilePath, bool bCompress, FGDMOnLogExportProgress OnProgress, FGDMOnLogExportCompleted OnCompleted) const;
+
 	TArray<FString> GetCommandHistory() const;
 	void ClearCommandHistory();
 };
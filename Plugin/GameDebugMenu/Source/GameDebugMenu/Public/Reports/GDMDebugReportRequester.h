@@ -54,6 +54,9 @@ protected:
 
 	FString GetDescription();
 
+	/* 添付するゲーム内ログ（ReportLogDurationSecondsが設定されていればメニューを開く前の範囲のみ） */
+	void GetReportLogString(FString& OutLog);
+
 	UFUNCTION(BlueprintNativeEvent)
 	FString PrefixSubjectString();
 	
@@ -0,0 +1,41 @@
+/**
+* Copyright (c) 2020 akihiko moroi
+*
+* This software is released under the MIT License.
+* (See accompanying file LICENSE.txt or copy at http://opensource.org/licenses/MIT)
+*/
+
+#include "GDMSettingsCustomization.h"
+#include "DetailLayoutBuilder.h"
+#include "IPropertyUtilities.h"
+#include "GameDebugMenuSettings.h"
+
+/************************************************************************/
+/* FGDMSettingsCustomization											*/
+/************************************************************************/
+
+TSharedRef<IDetailCustomization> FGDMSettingsCustomization::MakeInstance()
+{
+	return MakeShareable(new FGDMSettingsCustomization());
+}
+
+void FGDMSettingsCustomization::CustomizeDetails(IDetailLayoutBuilder& DetailBuilder)
+{
+	TArray<TWeakObjectPtr<UObject>> Objects;
+	DetailBuilder.GetObjectsBeingCustomized(Objects);
+
+	bool bApplied = false;
+	for( const TWeakObjectPtr<UObject>& Object : Objects )
+	{
+		if( UGameDebugMenuSettings* Settings = Cast<UGameDebugMenuSettings>(Object.Get()) )
+		{
+			bApplied |= Settings->ApplyDefaultConsoleCommandsToUnsetArrays();
+		}
+	}
+
+	if( bApplied )
+	{
+		/* 配列の要素数が変わったので表示を作り直す（2回目以降はセット済みなので何もしない） */
+		DetailBuilder.GetPropertyUtilities()->RequestRefresh();
+	}
+}
@@ -16,6 +16,7 @@
 #include <EdGraphUtilities.h>
 
 #include "GDMGameplayCategoryKeyCustomization.h"
+#include "GDMSettingsCustomization.h"
 #include "Pins/GDMGameplayCategoryKeyPinFactory.h"
 
 
@@ -33,6 +34,7 @@ void FGameDebugMenuEditorModule::StartupModule()
 
 	FPropertyEditorModule& PropertyModule = FModuleManager::LoadModuleChecked<FPropertyEditorModule>("PropertyEditor");
 	PropertyModule.RegisterCustomPropertyTypeLayout("GDMGameplayCategoryKey", FOnGetPropertyTypeCustomizationInstance::CreateStatic(&FGDMGameplayCategoryKeyCustomization::MakeInstance));
+	PropertyModule.RegisterCustomClassLayout(UGameDebugMenuSettings::StaticClass()->GetFName(), FOnGetDetailCustomizationInstance::CreateStatic(&FGDMSettingsCustomization::MakeInstance));
 
 	GameplayCategoryKeyPinFactory = MakeShareable(new FGDMGameplayCategoryKeyPinFactory());
 	FEdGraphUtilities::RegisterVisualPinFactory(GameplayCategoryKeyPinFactory);
@@ -52,6 +54,7 @@ void FGameDebugMenuEditorModule::ShutdownModule()
 
 	FPropertyEditorModule& PropertyModule = FModuleManager::LoadModuleChecked<FPropertyEditorModule>("PropertyEditor");
 	PropertyModule.UnregisterCustomPropertyTypeLayout("GDMGameplayCategoryKey");
+	PropertyModule.UnregisterCustomClassLayout(UGameDebugMenuSettings::StaticClass()->GetFName());
 
 	FEdGraphUtilities::UnregisterVisualPinFactory(GameplayCategoryKeyPinFactory);
 	GameplayCategoryKeyPinFactory = nullptr;
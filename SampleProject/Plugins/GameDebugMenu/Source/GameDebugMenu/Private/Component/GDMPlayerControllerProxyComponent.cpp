@@ -14,8 +14,11 @@
 
 UGDMPlayerControllerProxyComponent::UGDMPlayerControllerProxyComponent()
 {
-	PrimaryComponentTick.bCanEverTick          = false;
+	/* 送信待ちのコマンドがある間だけTickする */
+	PrimaryComponentTick.bCanEverTick          = true;
 	PrimaryComponentTick.bStartWithTickEnabled = false;
+	PrimaryComponentTick.bTickEvenWhenPaused   = true;
+	PrimaryComponentTick.TickGroup             = TG_PostUpdateWork;
 	SetIsReplicatedByDefault(true);
 }
 
@@ -34,10 +37,19 @@ void UGDMPlayerControllerProxyComponent::BeginPlay()
 
 void UGDMPlayerControllerProxyComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
+	PendingServerAllCommands.Reset();
+
 	Super::EndPlay(EndPlayReason);
 	UE_LOG(LogGDM, Log, TEXT("Call EndPlay Destroyed GDMPlayerControllerProxyComponent"));
 }
 
+void UGDMPlayerControllerProxyComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+	FlushPendingServerAllCommands();
+}
+
 APlayerController* UGDMPlayerControllerProxyComponent::GetOwnerPlayerController() const
 {
 	return Cast<APlayerController>(GetOwner());
@@ -87,9 +99,36 @@ bool UGDMPlayerControllerProxyComponent::ROS_ExecuteConsoleCommand_Validate(cons
 	return (!Command.IsEmpty());
 }
 
+void UGDMPlayerControllerProxyComponent::ROS_ExecuteConsoleCommands_Implementation(const TArray<FString>& Commands, bool bAllClient)
+{
+	if (bAllClient)
+	{
+		AllExecuteConsoleCommands_Server(Commands);
+	}
+	else
+	{
+		ROC_ExecuteConsoleCommands(Commands);
+	}
+}
+
+bool UGDMPlayerControllerProxyComponent::ROS_ExecuteConsoleCommands_Validate(const TArray<FString>& Commands, bool bAllClient)
+{
+	return (Commands.Num() > 0 && Commands.Num() <= MaxBatchedConsoleCommands);
+}
+
+void UGDMPlayerControllerProxyComponent::ROC_ExecuteConsoleCommands_Implementation(const TArray<FString>& Commands)
+{
+	GetDebugMenuManager()->EnqueueConsoleCommands(Commands, GetOwnerPlayerController());
+}
+
+bool UGDMPlayerControllerProxyComponent::ROC_ExecuteConsoleCommands_Validate(const TArray<FString>& Commands)
+{
+	return (Commands.Num() > 0 && Commands.Num() <= MaxBatchedConsoleCommands);
+}
+
 void UGDMPlayerControllerProxyComponent::ROC_ExecuteConsoleCommand_Implementation(const FString& Command)
 {
-	GetDebugMenuManager()->ExecuteConsoleCommand(Command, GetOwnerPlayerController());
+	GetDebugMenuManager()->EnqueueConsoleCommand(Command, GetOwnerPlayerController());
 }
 
 bool UGDMPlayerControllerProxyComponent::ROC_ExecuteConsoleCommand_Validate(const FString& Command)
@@ -97,15 +136,14 @@ bool UGDMPlayerControllerProxyComponent::ROC_ExecuteConsoleCommand_Validate(cons
 	return (!Command.IsEmpty());
 }
 
-void UGDMPlayerControllerProxyComponent::ExecuteConsoleCommand(const FString& Command, EGDMConsoleCommandNetType CommandNetType)
+int32 UGDMPlayerControllerProxyComponent::ExecuteConsoleCommand(const FString& Command, EGDMConsoleCommandNetType CommandNetType)
 {
 	switch (CommandNetType)
 	{
 		case EGDMConsoleCommandNetType::LocalOnly:
 		{
-			/* 通信せず実行者の環境で実行する */
-			GetDebugMenuManager()->ExecuteConsoleCommand(Command, GetOwnerPlayerController());
-			break;
+			/* 通信せず実行者の環境で実行する（BPのコマンドグループから続けて呼ばれても予算を超えた分は次のフレームへ回す） */
+			return GetDebugMenuManager()->EnqueueConsoleCommand(Command, GetOwnerPlayerController());
 		}
 		case EGDMConsoleCommandNetType::ServerAll:
 		{
@@ -116,7 +154,8 @@ void UGDMPlayerControllerProxyComponent::ExecuteConsoleCommand(const FString& Co
 			}
 			else
 			{
-				ROS_ExecuteConsoleCommand(Command,true);
+				/* 同じフレームのコマンドはまとめて1回のRPCで送る */
+				AddPendingServerAllCommand(Command);
 			}
 			break;
 		}
@@ -125,6 +164,33 @@ void UGDMPlayerControllerProxyComponent::ExecuteConsoleCommand(const FString& Co
 			break;
 		}
 	}
+
+	return INDEX_NONE;
+}
+
+int32 UGDMPlayerControllerProxyComponent::ExecuteConsoleCommands(const TArray<FString>& Commands, EGDMConsoleCommandNetType CommandNetType)
+{
+	if (CommandNetType == EGDMConsoleCommandNetType::LocalOnly)
+	{
+		return GetDebugMenuManager()->EnqueueConsoleCommands(Commands, GetOwnerPlayerController());
+	}
+
+	if (CommandNetType == EGDMConsoleCommandNetType::ServerAll)
+	{
+		if (GetOwner()->HasAuthority())
+		{
+			AllExecuteConsoleCommands_Server(Commands);
+		}
+		else
+		{
+			for (const FString& Command : Commands)
+			{
+				AddPendingServerAllCommand(Command);
+			}
+		}
+	}
+
+	return INDEX_NONE;
 }
 
 void UGDMPlayerControllerProxyComponent::AllExecuteConsoleCommand_Server(const FString& Command)
@@ -137,6 +203,73 @@ void UGDMPlayerControllerProxyComponent::AllExecuteConsoleCommand_Server(const F
 			continue;
 		}
 
-		GetDebugMenuManager()->ExecuteConsoleCommand(Command, PC);
+		GetDebugMenuManager()->EnqueueConsoleCommand(Command, PC);
+	}
+}
+
+void UGDMPlayerControllerProxyComponent::AllExecuteConsoleCommands_Server(const TArray<FString>& Commands)
+{
+	for (FConstPlayerControllerIterator Iterator = GetWorld()->GetPlayerControllerIterator(); Iterator; ++Iterator)
+	{
+		APlayerController* PC = Iterator->Get();
+		if (!IsValid(PC))
+		{
+			continue;
+		}
+
+		GetDebugMenuManager()->EnqueueConsoleCommands(Commands, PC);
+	}
+}
+
+void UGDMPlayerControllerProxyComponent::AddPendingServerAllCommand(const FString& Command)
+{
+	if (Command.IsEmpty())
+	{
+		return;
+	}
+
+	/* 同じフレームで連続した同じコマンドは1回だけ送る */
+	if (PendingServerAllCommands.Num() > 0 && PendingServerAllCommands.Last() == Command)
+	{
+		return;
+	}
+
+	PendingServerAllCommands.Add(Command);
+	SetComponentTickEnabled(true);
+}
+
+void UGDMPlayerControllerProxyComponent::FlushPendingServerAllCommands()
+{
+	SetComponentTickEnabled(false);
+
+	if (PendingServerAllCommands.Num() <= 0)
+	{
+		return;
+	}
+
+	/* 上限を超える分は分割して送る */
+	ForEachConsoleCommandBatch(PendingServerAllCommands, [this](const TArray<FString>& Batch)
+	{
+		ROS_ExecuteConsoleCommands(Batch, true);
+	});
+
+	PendingServerAllCommands.Reset();
+}
+
+void UGDMPlayerControllerProxyComponent::ForEachConsoleCommandBatch(const TArray<FString>& Commands, TFunctionRef<void(const TArray<FString>&)> Send)
+{
+	if (Commands.Num() <= MaxBatchedConsoleCommands)
+	{
+		if (Commands.Num() > 0)
+		{
+			Send(Commands);
+		}
+		return;
+	}
+
+	for (int32 Start = 0; Start < Commands.Num(); Start += MaxBatchedConsoleCommands)
+	{
+		const int32 Count = FMath::Min(MaxBatchedConsoleCommands, Commands.Num() - Start);
+		Send(TArray<FString>(Commands.GetData() + Start, Count));
 	}
 }
@@ -0,0 +1,417 @@
+/**
+* Copyright (c) 2020 akihiko moroi
+*
+* This software is released under the MIT License.
+* (See accompanying file LICENSE.txt or copy at http://opensource.org/licenses/MIT)
+*/
+
+#include "ConsoleCommand/GDMConsoleCommandSearchIndex.h"
+
+#include "Data/GDMConsoleCommandSetAsset.h"
+#include "Internationalization/TextLocalizationManager.h"
+
+namespace
+{
+	/* 項目ごとの重み（タイトル > コマンド > カテゴリ > 説明） */
+	constexpr float FieldWeights[FGDMConsoleCommandSearchIndex::Field_Num] = { 8.0f, 6.0f, 3.0f, 1.0f };
+
+	/* 単語の前方一致は部分一致より上位にする */
+	constexpr float PrefixMatchScale    = 2.0f;
+	constexpr float SubstringMatchScale = 1.0f;
+
+	/* 語のトライグラムがこの割合以上含まれていればあいまい一致とする */
+	constexpr float FuzzyMatchThreshold = 0.6f;
+	constexpr float FuzzyMatchScale     = 0.5f;
+
+	constexpr int32 TrigramLen = 3;
+
+	FORCEINLINE uint64 MakeTrigramKey(const TCHAR* Chars)
+	{
+		/* 1文字21bitあればUnicode全域を表せる */
+		return (static_cast<uint64>(Chars[0]) << 42) | (static_cast<uint64>(Chars[1]) << 21) | static_cast<uint64>(Chars[2]);
+	}
+
+	FString JoinCommandText(std::initializer_list<const FString*> Texts)
+	{
+		FString Result;
+		for (const FString* Text : Texts)
+		{
+			if (!Text->IsEmpty())
+			{
+				if (!Result.IsEmpty())
+				{
+					Result.AppendChar(TEXT(' '));
+				}
+				Result.Append(*Text);
+			}
+		}
+		return Result;
+	}
+}
+
+void FGDMConsoleCommandSearchIndex::Build(const UGDMConsoleCommandSetAsset& Asset)
+{
+	Reset();
+
+	TMap<int32, FString> CategoryTitles;
+	for (const FGDMOrderMenuCategoryTitle& CategoryTitle : Asset.OrderConsoleCommandCategoryTitles)
+	{
+		CategoryTitles.Add(CategoryTitle.Index, CategoryTitle.Title);
+	}
+
+	auto GetCategoryTitle = [&CategoryTitles](const FGDMConsoleCommand& Command)
+	{
+		const FString* CategoryTitle = CategoryTitles.Find(Command.CategoryIndex);
+		return (CategoryTitle != nullptr) ? *CategoryTitle : FString();
+	};
+
+	const int32 NumNames = Asset.GetNumConsoleCommandNames();
+	for (int32 Index = 0; Index < NumNames; ++Index)
+	{
+		FGDMConsoleCommandSingle Command;
+		if (Asset.GetConsoleCommandNameByArrayIndex(Index, Command))
+		{
+			AddEntry(EGDMConsoleCommandType::Single, Index, Command.Title.ToString(), Command.ConsoleCommandName, GetCategoryTitle(Command), Command.Description.ToString());
+		}
+	}
+
+	const int32 NumGroups = Asset.GetNumConsoleCommandGroups();
+	for (int32 Index = 0; Index < NumGroups; ++Index)
+	{
+		FGDMConsoleCommandGroup Command;
+		if (Asset.GetConsoleCommandGroupByArrayIndex(Index, Command))
+		{
+			AddEntry(EGDMConsoleCommandType::Group, Index, Command.Title.ToString(), FString::Join(Command.ConsoleCommandNames, TEXT(" ")), GetCategoryTitle(Command), Command.Description.ToString());
+		}
+	}
+
+	const int32 NumPairs = Asset.GetNumConsoleCommandPairs();
+	for (int32 Index = 0; Index < NumPairs; ++Index)
+	{
+		FGDMConsoleCommandPair Command;
+		if (Asset.GetConsoleCommandPairByArrayIndex(Index, Command))
+		{
+			const FString CommandText = JoinCommandText({ &Command.FirstConsoleCommandName, &Command.SecondConsoleCommandName });
+			AddEntry(EGDMConsoleCommandType::Pair, Index, Command.Title.ToString(), CommandText, GetCategoryTitle(Command), Command.Description.ToString());
+		}
+	}
+
+	const int32 NumNumbers = Asset.GetNumConsoleCommandNumbers();
+	for (int32 Index = 0; Index < NumNumbers; ++Index)
+	{
+		FGDMConsoleCommandNumber Command;
+		if (Asset.GetConsoleCommandNumberByArrayIndex(Index, Command))
+		{
+			const FString CommandText = JoinCommandText({ &Command.PreConsoleCommandName, &Command.ConsoleCommandName, &Command.PostConsoleCommandName, &Command.ConsoleVariableName });
+			AddEntry(EGDMConsoleCommandType::Number, Index, Command.Title.ToString(), CommandText, GetCategoryTitle(Command), Command.Description.ToString());
+		}
+	}
+
+	BuiltTextRevision = FTextLocalizationManager::Get().GetTextRevision();
+	bBuilt = true;
+}
+
+bool FGDMConsoleCommandSearchIndex::IsUpToDate() const
+{
+	return bBuilt && BuiltTextRevision == FTextLocalizationManager::Get().GetTextRevision();
+}
+
+void FGDMConsoleCommandSearchIndex::Reset()
+{
+	Entries.Reset();
+	TrieNodes.Reset();
+	TrieNodes.AddDefaulted();
+	TrigramPostings.Reset();
+	LastQuery.Reset();
+	LastMatches.Empty();
+	bBuilt = false;
+}
+
+void FGDMConsoleCommandSearchIndex::Search(const FString& Query, int32 MaxResults, TArray<FGDMConsoleCommandSearchResult>& OutResults)
+{
+	OutResults.Reset();
+
+	const FString NormalizedQuery = Query.TrimStartAndEnd().ToLower();
+	TArray<FString> Tokens;
+	NormalizedQuery.ParseIntoArrayWS(Tokens);
+	if (Tokens.Num() <= 0 || MaxResults <= 0)
+	{
+		LastQuery.Reset();
+		LastMatches.Empty();
+		return;
+	}
+
+	/* 前回の入力に文字を追加しただけなら、前回一致したものだけを対象にする
+	 * 前方一致と部分一致は文字を足すと一致が減る一方だが、あいまい一致は語が長くなると新たに一致することがあるので
+	 * あいまい一致する語がある場合は入力履歴で結果が変わらないように全体から探す */
+	const bool bCanNarrow = !Tokens.ContainsByPredicate(&FGDMConsoleCommandSearchIndex::CanFuzzyMatch);
+
+	TBitArray<> Candidates;
+	if (bCanNarrow && !LastQuery.IsEmpty() && LastMatches.Num() == Entries.Num() && NormalizedQuery.StartsWith(LastQuery, ESearchCase::CaseSensitive))
+	{
+		Candidates = LastMatches;
+	}
+	else
+	{
+		Candidates.Init(true, Entries.Num());
+	}
+
+	TArray<float> TotalScores;
+	TotalScores.SetNumZeroed(Entries.Num());
+
+	TArray<float> TokenScores;
+	for (const FString& Token : Tokens)
+	{
+		ScoreToken(Token, Candidates, TokenScores);
+
+		/* 全ての語に一致したものだけ残す */
+		for (int32 EntryIndex = 0; EntryIndex < Entries.Num(); ++EntryIndex)
+		{
+			if (!Candidates[EntryIndex])
+			{
+				continue;
+			}
+
+			if (TokenScores[EntryIndex] > 0.0f)
+			{
+				TotalScores[EntryIndex] += TokenScores[EntryIndex];
+			}
+			else
+			{
+				Candidates[EntryIndex] = false;
+			}
+		}
+	}
+
+	LastQuery   = NormalizedQuery;
+	LastMatches = Candidates;
+
+	/* スコア上位MaxResults件だけを、先頭が最下位になるヒープで保持する */
+	struct FScoredEntry
+	{
+		float Score;
+		int32 EntryIndex;
+	};
+
+	auto IsBetter = [](const FScoredEntry& A, const FScoredEntry& B)
+	{
+		return (A.Score != B.Score) ? (A.Score > B.Score) : (A.EntryIndex < B.EntryIndex);
+	};
+	auto IsWorse = [&IsBetter](const FScoredEntry& A, const FScoredEntry& B)
+	{
+		return IsBetter(B, A);
+	};
+
+	TArray<FScoredEntry> TopEntries;
+	TopEntries.Reserve(MaxResults);
+	for (TConstSetBitIterator<> It(Candidates); It; ++It)
+	{
+		const FScoredEntry Scored{ TotalScores[It.GetIndex()], It.GetIndex() };
+		if (TopEntries.Num() < MaxResults)
+		{
+			TopEntries.HeapPush(Scored, IsWorse);
+		}
+		else if (IsBetter(Scored, TopEntries.HeapTop()))
+		{
+			TopEntries.HeapPopDiscard(IsWorse, EAllowShrinking::No);
+			TopEntries.HeapPush(Scored, IsWorse);
+		}
+	}
+
+	TopEntries.Sort(IsBetter);
+
+	OutResults.Reserve(TopEntries.Num());
+	for (const FScoredEntry& Scored : TopEntries)
+	{
+		const FEntry& Entry = Entries[Scored.EntryIndex];
+
+		FGDMConsoleCommandSearchResult& Result = OutResults.AddDefaulted_GetRef();
+		Result.Type       = Entry.Type;
+		Result.ArrayIndex = Entry.ArrayIndex;
+		Result.Score      = Scored.Score;
+	}
+}
+
+void FGDMConsoleCommandSearchIndex::AddEntry(EGDMConsoleCommandType Type, int32 ArrayIndex, const FString& Title, const FString& Command, const FString& Category, const FString& Description)
+{
+	const int32 EntryIndex = Entries.AddDefaulted();
+	FEntry& Entry = Entries[EntryIndex];
+	Entry.Type                         = Type;
+	Entry.ArrayIndex                   = ArrayIndex;
+	Entry.Fields[Field_Title]          = Title.ToLower();
+	Entry.Fields[Field_Command]        = Command.ToLower();
+	Entry.Fields[Field_Category]       = Category.ToLower();
+	Entry.Fields[Field_Description]    = Description.ToLower();
+
+	for (int32 FieldIndex = 0; FieldIndex < Field_Num; ++FieldIndex)
+	{
+		const FString& Text = Entry.Fields[FieldIndex];
+		const uint32 Posting = (static_cast<uint32>(EntryIndex) << 2) | static_cast<uint32>(FieldIndex);
+
+		/* 英数字の連続を1単語としてトライに登録 */
+		int32 WordStart = INDEX_NONE;
+		for (int32 CharIndex = 0; CharIndex <= Text.Len(); ++CharIndex)
+		{
+			const bool bWordChar = (CharIndex < Text.Len()) && FChar::IsAlnum(Text[CharIndex]);
+			if (bWordChar && WordStart == INDEX_NONE)
+			{
+				WordStart = CharIndex;
+			}
+			else if (!bWordChar && WordStart != INDEX_NONE)
+			{
+				AddWord(*Text + WordStart, CharIndex - WordStart, Posting);
+				WordStart = INDEX_NONE;
+			}
+		}
+
+		AddTrigrams(Text, EntryIndex);
+	}
+}
+
+void FGDMConsoleCommandSearchIndex::AddWord(const TCHAR* Word, int32 Len, uint32 Posting)
+{
+	int32 NodeIndex = 0;
+	for (int32 Index = 0; Index < Len; ++Index)
+	{
+		if (const int32* Child = TrieNodes[NodeIndex].Children.Find(Word[Index]))
+		{
+			NodeIndex = *Child;
+		}
+		else
+		{
+			const int32 NewIndex = TrieNodes.AddDefaulted();
+			TrieNodes[NodeIndex].Children.Add(Word[Index], NewIndex);
+			NodeIndex = NewIndex;
+		}
+
+		/* Entry、項目の順に登録するので重複は直前の要素だけ見ればよい */
+		TArray<uint32>& Postings = TrieNodes[NodeIndex].Postings;
+		if (Postings.Num() <= 0 || Postings.Last() != Posting)
+		{
+			Postings.Add(Posting);
+		}
+	}
+}
+
+void FGDMConsoleCommandSearchIndex::AddTrigrams(const FString& Text, int32 EntryIndex)
+{
+	for (int32 Index = 0; Index + TrigramLen <= Text.Len(); ++Index)
+	{
+		TArray<int32>& Postings = TrigramPostings.FindOrAdd(MakeTrigramKey(*Text + Index));
+		if (Postings.Num() <= 0 || Postings.Last() != EntryIndex)
+		{
+			Postings.Add(EntryIndex);
+		}
+	}
+}
+
+void FGDMConsoleCommandSearchIndex::ScoreToken(const FString& Token, const TBitArray<>& Candidates, TArray<float>& OutTokenScores) const
+{
+	OutTokenScores.Reset();
+	OutTokenScores.SetNumZeroed(Entries.Num());
+
+	/* 単語の前方一致 */
+	int32 NodeIndex = 0;
+	for (const TCHAR Char : Token)
+	{
+		const int32* Child = TrieNodes[NodeIndex].Children.Find(Char);
+		if (Child == nullptr)
+		{
+			NodeIndex = INDEX_NONE;
+			break;
+		}
+		NodeIndex = *Child;
+	}
+
+	if (NodeIndex > 0)
+	{
+		for (const uint32 Posting : TrieNodes[NodeIndex].Postings)
+		{
+			const int32 EntryIndex = static_cast<int32>(Posting >> 2);
+			if (Candidates[EntryIndex])
+			{
+				OutTokenScores[EntryIndex] = FMath::Max(OutTokenScores[EntryIndex], FieldWeights[Posting & 3] * PrefixMatchScale);
+			}
+		}
+	}
+
+	/* 部分一致（項目は重み順なので最初に見つかったものが最大） */
+	auto ScoreSubstring = [this, &Token, &OutTokenScores](int32 EntryIndex)
+	{
+		const FEntry& Entry = Entries[EntryIndex];
+		for (int32 FieldIndex = 0; FieldIndex < Field_Num; ++FieldIndex)
+		{
+			if (Entry.Fields[FieldIndex].Contains(Token, ESearchCase::CaseSensitive))
+			{
+				OutTokenScores[EntryIndex] = FMath::Max(OutTokenScores[EntryIndex], FieldWeights[FieldIndex] * SubstringMatchScale);
+				return;
+			}
+		}
+	};
+
+	if (Token.Len() < TrigramLen)
+	{
+		/* トライグラムを作れない短い語は候補を直接調べる */
+		for (TConstSetBitIterator<> It(Candidates); It; ++It)
+		{
+			if (OutTokenScores[It.GetIndex()] <= 0.0f)
+			{
+				ScoreSubstring(It.GetIndex());
+			}
+		}
+		return;
+	}
+
+	TArray<uint64, TInlineAllocator<32>> Trigrams;
+	for (int32 Index = 0; Index + TrigramLen <= Token.Len(); ++Index)
+	{
+		Trigrams.AddUnique(MakeTrigramKey(*Token + Index));
+	}
+
+	TArray<int32> TrigramHits;
+	TrigramHits.SetNumZeroed(Entries.Num());
+	TArray<int32> HitEntries;
+	for (const uint64 Key : Trigrams)
+	{
+		if (const TArray<int32>* Postings = TrigramPostings.Find(Key))
+		{
+			for (const int32 EntryIndex : *Postings)
+			{
+				if (Candidates[EntryIndex] && TrigramHits[EntryIndex]++ == 0)
+				{
+					HitEntries.Add(EntryIndex);
+				}
+			}
+		}
+	}
+
+	/* 全てのトライグラムを含むものは部分一致を確認し、一定以上含むものはあいまい一致とする（CanFuzzyMatchと条件を合わせる） */
+	const int32 NumTrigrams = Trigrams.Num();
+	for (const int32 EntryIndex : HitEntries)
+	{
+		if (TrigramHits[EntryIndex] == NumTrigrams)
+		{
+			ScoreSubstring(EntryIndex);
+		}
+
+		const float Ratio = static_cast<float>(TrigramHits[EntryIndex]) / NumTrigrams;
+		if (NumTrigrams > 1 && Ratio >= FuzzyMatchThreshold)
+		{
+			OutTokenScores[EntryIndex] = FMath::Max(OutTokenScores[EntryIndex], FuzzyMatchScale * Ratio);
+		}
+	}
+}
+
+bool FGDMConsoleCommandSearchIndex::CanFuzzyMatch(const FString& Token)
+{
+	/* トライグラムが2種類以上ある語はあいまい一致の対象 */
+	for (int32 Index = 1; Index + TrigramLen <= Token.Len(); ++Index)
+	{
+		if (FCString::Strncmp(*Token, *Token + Index, TrigramLen) != 0)
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
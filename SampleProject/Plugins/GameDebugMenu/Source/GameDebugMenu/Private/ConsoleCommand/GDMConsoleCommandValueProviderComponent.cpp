@@ -16,19 +16,34 @@ UGDMConsoleCommandValueProviderComponent::UGDMConsoleCommandValueProviderCompone
 	PrimaryComponentTick.bStartWithTickEnabled = false;
 }
 
+#if WITH_EDITOR
+void UGDMConsoleCommandValueProviderComponent::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+
+	InvalidatePatterns();
+}
+#endif
+
 bool UGDMConsoleCommandValueProviderComponent::GetFloatValue(const FString& CommandName, float& OutValue)
 {
-	for (const FGDMConsoleCommandProviderPattern& PatternStruct : ProviderPatterns)
+	int32* ResolvedIndex = ResolvedPatternIndices.Find(CommandName);
+	if (ResolvedIndex == nullptr)
 	{
-		if (PatternStruct.Pattern.IsEmpty() || !IsValid(PatternStruct.Provider))
-		{
-			continue;
-		}
-		
-		if (CommandName.Contains(PatternStruct.Pattern))
+		ResolvedIndex = &ResolvedPatternIndices.Add(CommandName, MatchPattern(CommandName));
+	}
+
+	if (ProviderPatterns.IsValidIndex(*ResolvedIndex))
+	{
+		const FGDMConsoleCommandProviderPattern& PatternStruct = ProviderPatterns[*ResolvedIndex];
+		if (IsValid(PatternStruct.Provider))
 		{
 			return PatternStruct.Provider->GetFloatValue(CommandName, OutValue);
 		}
+
+		/* Providerが無効になっていたら照合し直す */
+		InvalidatePatterns();
+		return GetFloatValue(CommandName, OutValue);
 	}
 	
 	if (IsValid(ConsoleVariableCommandValueProvider))
@@ -39,4 +54,81 @@ bool UGDMConsoleCommandValueProviderComponent::GetFloatValue(const FString& Comm
 	return false;
 }
 
+void UGDMConsoleCommandValueProviderComponent::InvalidatePatterns()
+{
+	PatternNodes.Reset();
+	ResolvedPatternIndices.Reset();
+	bPatternsCompiled = false;
+}
+
+void UGDMConsoleCommandValueProviderComponent::CompilePatterns()
+{
+	PatternNodes.Reset();
+	PatternNodes.AddDefaulted();
+
+	for (int32 Index = 0; Index < ProviderPatterns.Num(); ++Index)
+	{
+		const FGDMConsoleCommandProviderPattern& PatternStruct = ProviderPatterns[Index];
+		if (PatternStruct.Pattern.IsEmpty() || !IsValid(PatternStruct.Provider))
+		{
+			continue;
+		}
+
+		int32 NodeIndex = 0;
+		for (const TCHAR Char : PatternStruct.Pattern)
+		{
+			const TCHAR Key = FChar::ToLower(Char);
+			if (const int32* Child = PatternNodes[NodeIndex].Children.Find(Key))
+			{
+				NodeIndex = *Child;
+			}
+			else
+			{
+				const int32 NewIndex = PatternNodes.AddDefaulted();
+				PatternNodes[NodeIndex].Children.Add(Key, NewIndex);
+				NodeIndex = NewIndex;
+			}
+		}
+
+		/* 同じパターンが複数ある場合は先に登録されたものを使う */
+		if (PatternNodes[NodeIndex].PatternIndex == INDEX_NONE)
+		{
+			PatternNodes[NodeIndex].PatternIndex = Index;
+		}
+	}
+
+	bPatternsCompiled = true;
+}
+
+int32 UGDMConsoleCommandValueProviderComponent::MatchPattern(const FString& CommandName)
+{
+	if (!bPatternsCompiled)
+	{
+		CompilePatterns();
+	}
+
+	/* FString::Containsと同じく大文字小文字は区別せず、ProviderPatternsの先頭に近いものを優先する */
+	int32 BestIndex = INDEX_NONE;
+	const int32 Len = CommandName.Len();
+	for (int32 Start = 0; Start < Len; ++Start)
+	{
+		int32 NodeIndex = 0;
+		for (int32 Index = Start; Index < Len; ++Index)
+		{
+			const int32* Child = PatternNodes[NodeIndex].Children.Find(FChar::ToLower(CommandName[Index]));
+			if (Child == nullptr)
+			{
+				break;
+			}
 
+			NodeIndex = *Child;
+			const int32 PatternIndex = PatternNodes[NodeIndex].PatternIndex;
+			if (PatternIndex != INDEX_NONE && (BestIndex == INDEX_NONE || PatternIndex < BestIndex))
+			{
+				BestIndex = PatternIndex;
+			}
+		}
+	}
+
+	return BestIndex;
+}
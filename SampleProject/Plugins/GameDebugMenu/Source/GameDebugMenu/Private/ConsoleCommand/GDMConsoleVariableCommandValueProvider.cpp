@@ -7,13 +7,39 @@
 
 #include "ConsoleCommand/GDMConsoleVariableCommandValueProvider.h"
 
+#include "HAL/IConsoleManager.h"
+
 bool UGDMConsoleVariableCommandValueProvider::GetFloatValue_Implementation(const FString& CommandName, float& OutValue) const
 {
-	if (const IConsoleVariable* Var = IConsoleManager::Get().FindConsoleVariable(*CommandName))
+	if (const IConsoleVariable* Variable = FindOrResolveConsoleVariable(CommandName))
 	{
-		OutValue = Var->GetFloat();
+		OutValue = Variable->GetFloat();
 		return true;
 	}
 	
 	return false;
 }
+
+IConsoleVariable* UGDMConsoleVariableCommandValueProvider::FindOrResolveConsoleVariable(const FString& CommandName) const
+{
+	if (IConsoleVariable** Cached = CachedConsoleVariables.Find(CommandName))
+	{
+		/* 登録解除された場合のみ解決し直す */
+		if (!(*Cached)->TestFlags(ECVF_Unregistered))
+		{
+			return *Cached;
+		}
+
+		CachedConsoleVariables.Remove(CommandName);
+	}
+
+	IConsoleVariable* Variable = IConsoleManager::Get().FindConsoleVariable(*CommandName);
+	if (Variable == nullptr || Variable->TestFlags(ECVF_Unregistered))
+	{
+		/* 後から登録される場合があるので見つからなかったものは保持しない */
+		return nullptr;
+	}
+
+	CachedConsoleVariables.Add(CommandName, Variable);
+	return Variable;
+}
@@ -9,10 +9,22 @@
 
 #include "GameDebugMenuSettings.h"
 
+namespace
+{
+	/* 通常の配列の後ろにEditorOnlyの配列が続く並びでのIndexから取得 */
+	template<typename TCommand>
+	const TCommand& GetCommandByCombinedIndex(const TArray<TCommand>& Commands, const TArray<TCommand>& EditorOnlyCommands, int32 CombinedIndex)
+	{
+		return (CombinedIndex < Commands.Num()) ? Commands[CombinedIndex] : EditorOnlyCommands[CombinedIndex - Commands.Num()];
+	}
+}
+
 void UGDMConsoleCommandSetAsset::SetupCommandNames()
 {
 #if WITH_EDITORONLY_DATA
-	const UGameDebugMenuSettings* Settings = GetDefault<UGameDebugMenuSettings>();
+	/* INIで設定されていない配列はプラグイン既定のコマンドを使用（Project Settingsを開いた時などに済んでいれば何もしない） */
+	UGameDebugMenuSettings* Settings = GetMutableDefault<UGameDebugMenuSettings>();
+	Settings->ApplyDefaultConsoleCommandsToUnsetArrays();
 
 	auto FilterByCategory = [this](const auto& CommandArray, auto& OutArray)
 	{
@@ -46,6 +58,7 @@ void UGDMConsoleCommandSetAsset::SetupCommandNames()
 	FilterByCategory(Settings->EditorOnlyConsoleCommandPairs, EditorOnlyConsoleCommandPairs);
 	FilterByCategory(Settings->EditorOnlyConsoleCommandNumbers, EditorOnlyConsoleCommandNumbers);
 
+	MarkCommandIndexDirty();
 	this->Modify();
 #endif
 }
@@ -62,15 +75,44 @@ void UGDMConsoleCommandSetAsset::SetupOrderConsoleCommandCategoryTitles()
 void UGDMConsoleCommandSetAsset::MergeFromSourceAssets()
 {
 #if WITH_EDITORONLY_DATA
-	auto MergeCommands = [](auto& Target, const auto& Source)
+	/* 既存の識別子を一度だけ作成し、Setで重複判定する */
+	auto BuildIdentifierSet = [](const auto& Target)
 	{
+		TSet<FString> Identifiers;
+		Identifiers.Reserve(Target.Num());
+		for (const auto& Existing : Target)
+		{
+			Identifiers.Add(Existing.BuildCommandIdentifier());
+		}
+		return Identifiers;
+	};
+
+	TSet<FString> NameIds = BuildIdentifierSet(ConsoleCommandNames);
+	TSet<FString> GroupIds = BuildIdentifierSet(ConsoleCommandGroups);
+	TSet<FString> PairIds = BuildIdentifierSet(ConsoleCommandPairs);
+	TSet<FString> NumberIds = BuildIdentifierSet(ConsoleCommandNumbers);
+	TSet<FString> EditorOnlyNameIds = BuildIdentifierSet(EditorOnlyConsoleCommandNames);
+	TSet<FString> EditorOnlyGroupIds = BuildIdentifierSet(EditorOnlyConsoleCommandGroups);
+	TSet<FString> EditorOnlyPairIds = BuildIdentifierSet(EditorOnlyConsoleCommandPairs);
+	TSet<FString> EditorOnlyNumberIds = BuildIdentifierSet(EditorOnlyConsoleCommandNumbers);
+
+	int32 NumConflicts = 0;
+	auto MergeCommands = [this, &NumConflicts](auto& Target, TSet<FString>& TargetIds, const auto& Source, const UGDMConsoleCommandSetAsset* SourceAsset)
+	{
+		Target.Reserve(Target.Num() + Source.Num());
 		for (const auto& Item : Source)
 		{
-			const FString NewId = Item.BuildCommandIdentifier();
-			if (!Target.ContainsByPredicate([&](const auto& Existing) { return Existing.BuildCommandIdentifier() == NewId; }))
+			FString NewId = Item.BuildCommandIdentifier();
+			bool bAlreadyInSet = false;
+			TargetIds.Add(NewId, &bAlreadyInSet);
+			if (bAlreadyInSet)
 			{
-				Target.Add(Item);
+				++NumConflicts;
+				UE_LOG(LogGDM, Verbose, TEXT("MergeFromSourceAssets: %s: Skip duplicate command [%s] from %s"), *GetName(), *NewId, *GetNameSafe(SourceAsset));
+				continue;
 			}
+
+			Target.Add(Item);
 		}
 	};
 	
@@ -81,17 +123,23 @@ void UGDMConsoleCommandSetAsset::MergeFromSourceAssets()
 			continue;
 		}
 
-		MergeCommands(ConsoleCommandNames, SourceAsset->ConsoleCommandNames);
-		MergeCommands(ConsoleCommandGroups, SourceAsset->ConsoleCommandGroups);
-		MergeCommands(ConsoleCommandPairs, SourceAsset->ConsoleCommandPairs);
-		MergeCommands(ConsoleCommandNumbers, SourceAsset->ConsoleCommandNumbers);
+		MergeCommands(ConsoleCommandNames, NameIds, SourceAsset->ConsoleCommandNames, SourceAsset);
+		MergeCommands(ConsoleCommandGroups, GroupIds, SourceAsset->ConsoleCommandGroups, SourceAsset);
+		MergeCommands(ConsoleCommandPairs, PairIds, SourceAsset->ConsoleCommandPairs, SourceAsset);
+		MergeCommands(ConsoleCommandNumbers, NumberIds, SourceAsset->ConsoleCommandNumbers, SourceAsset);
 
-		MergeCommands(EditorOnlyConsoleCommandNames, SourceAsset->EditorOnlyConsoleCommandNames);
-		MergeCommands(EditorOnlyConsoleCommandGroups, SourceAsset->EditorOnlyConsoleCommandGroups);
-		MergeCommands(EditorOnlyConsoleCommandPairs, SourceAsset->EditorOnlyConsoleCommandPairs);
-		MergeCommands(EditorOnlyConsoleCommandNumbers, SourceAsset->EditorOnlyConsoleCommandNumbers);
+		MergeCommands(EditorOnlyConsoleCommandNames, EditorOnlyNameIds, SourceAsset->EditorOnlyConsoleCommandNames, SourceAsset);
+		MergeCommands(EditorOnlyConsoleCommandGroups, EditorOnlyGroupIds, SourceAsset->EditorOnlyConsoleCommandGroups, SourceAsset);
+		MergeCommands(EditorOnlyConsoleCommandPairs, EditorOnlyPairIds, SourceAsset->EditorOnlyConsoleCommandPairs, SourceAsset);
+		MergeCommands(EditorOnlyConsoleCommandNumbers, EditorOnlyNumberIds, SourceAsset->EditorOnlyConsoleCommandNumbers, SourceAsset);
 	}
 
+	if (NumConflicts > 0)
+	{
+		UE_LOG(LogGDM, Log, TEXT("MergeFromSourceAssets: %s: Skipped %d duplicate commands"), *GetName(), NumConflicts);
+	}
+
+	MarkCommandIndexDirty();
 	this->Modify();
 #endif
 }
@@ -112,15 +160,12 @@ TArray<FGDMMenuCategoryKey> UGDMConsoleCommandSetAsset::GetOrderConsoleCommandCa
 bool UGDMConsoleCommandSetAsset::GetConsoleCommandNameByArrayIndex(const int32 ArrayIndex, FGDMConsoleCommandSingle& Out) const
 {
 #if WITH_EDITOR
-	TArray<FGDMConsoleCommandSingle> Commands;
-	Commands.Append(ConsoleCommandNames);
-	Commands.Append(EditorOnlyConsoleCommandNames);
-	if (!Commands.IsValidIndex(ArrayIndex))
+	if (ArrayIndex < 0 || ArrayIndex >= GetNumConsoleCommandNames())
 	{
 		return false;
 	}
 
-	Out = Commands[ArrayIndex];
+	Out = GetCommandByCombinedIndex(ConsoleCommandNames, EditorOnlyConsoleCommandNames, ArrayIndex);
 #else
 	const auto& Commands = ConsoleCommandNames;
 	if (!Commands.IsValidIndex(ArrayIndex))
@@ -136,10 +181,7 @@ bool UGDMConsoleCommandSetAsset::GetConsoleCommandNameByArrayIndex(const int32 A
 int32 UGDMConsoleCommandSetAsset::GetNumConsoleCommandNames() const
 {
 #if WITH_EDITOR
-	TArray<FGDMConsoleCommandSingle> Commands;
-	Commands.Append(ConsoleCommandNames);
-	Commands.Append(EditorOnlyConsoleCommandNames);
-	return Commands.Num();
+	return ConsoleCommandNames.Num() + EditorOnlyConsoleCommandNames.Num();
 #else
 	return ConsoleCommandNames.Num();
 #endif
@@ -148,15 +190,12 @@ int32 UGDMConsoleCommandSetAsset::GetNumConsoleCommandNames() const
 bool UGDMConsoleCommandSetAsset::GetConsoleCommandGroupByArrayIndex(const int32 ArrayIndex, FGDMConsoleCommandGroup& Out) const
 {
 #if WITH_EDITOR
-	TArray<FGDMConsoleCommandGroup> Commands;
-	Commands.Append(ConsoleCommandGroups);
-	Commands.Append(EditorOnlyConsoleCommandGroups);
-	if (!Commands.IsValidIndex(ArrayIndex))
+	if (ArrayIndex < 0 || ArrayIndex >= GetNumConsoleCommandGroups())
 	{
 		return false;
 	}
 
-	Out = Commands[ArrayIndex];
+	Out = GetCommandByCombinedIndex(ConsoleCommandGroups, EditorOnlyConsoleCommandGroups, ArrayIndex);
 #else
 	const auto& Commands = ConsoleCommandGroups;
 	if (!Commands.IsValidIndex(ArrayIndex))
@@ -172,10 +211,7 @@ bool UGDMConsoleCommandSetAsset::GetConsoleCommandGroupByArrayIndex(const int32
 int32 UGDMConsoleCommandSetAsset::GetNumConsoleCommandGroups() const
 {
 #if WITH_EDITOR
-	TArray<FGDMConsoleCommandGroup> Commands;
-	Commands.Append(ConsoleCommandGroups);
-	Commands.Append(EditorOnlyConsoleCommandGroups);
-	return Commands.Num();
+	return ConsoleCommandGroups.Num() + EditorOnlyConsoleCommandGroups.Num();
 #else
 	return ConsoleCommandGroups.Num();
 #endif
@@ -184,15 +220,12 @@ int32 UGDMConsoleCommandSetAsset::GetNumConsoleCommandGroups() const
 bool UGDMConsoleCommandSetAsset::GetConsoleCommandPairByArrayIndex(const int32 ArrayIndex, FGDMConsoleCommandPair& Out) const
 {
 #if WITH_EDITOR
-	TArray<FGDMConsoleCommandPair> Commands;
-	Commands.Append(ConsoleCommandPairs);
-	Commands.Append(EditorOnlyConsoleCommandPairs);
-	if (!Commands.IsValidIndex(ArrayIndex))
+	if (ArrayIndex < 0 || ArrayIndex >= GetNumConsoleCommandPairs())
 	{
 		return false;
 	}
 
-	Out = Commands[ArrayIndex];
+	Out = GetCommandByCombinedIndex(ConsoleCommandPairs, EditorOnlyConsoleCommandPairs, ArrayIndex);
 #else
 	const auto& Commands = ConsoleCommandPairs;
 	if (!Commands.IsValidIndex(ArrayIndex))
@@ -208,10 +241,7 @@ bool UGDMConsoleCommandSetAsset::GetConsoleCommandPairByArrayIndex(const int32 A
 int32 UGDMConsoleCommandSetAsset::GetNumConsoleCommandPairs() const
 {
 #if WITH_EDITOR
-	TArray<FGDMConsoleCommandPair> Commands;
-	Commands.Append(ConsoleCommandPairs);
-	Commands.Append(EditorOnlyConsoleCommandPairs);
-	return Commands.Num();
+	return ConsoleCommandPairs.Num() + EditorOnlyConsoleCommandPairs.Num();
 #else
 	return ConsoleCommandPairs.Num();
 #endif
@@ -220,15 +250,12 @@ int32 UGDMConsoleCommandSetAsset::GetNumConsoleCommandPairs() const
 bool UGDMConsoleCommandSetAsset::GetConsoleCommandNumberByArrayIndex(const int32 ArrayIndex, FGDMConsoleCommandNumber& Out) const
 {
 #if WITH_EDITOR
-	TArray<FGDMConsoleCommandNumber> Commands;
-	Commands.Append(ConsoleCommandNumbers);
-	Commands.Append(EditorOnlyConsoleCommandNumbers);
-	if (!Commands.IsValidIndex(ArrayIndex))
+	if (ArrayIndex < 0 || ArrayIndex >= GetNumConsoleCommandNumbers())
 	{
 		return false;
 	}
 
-	Out = Commands[ArrayIndex];
+	Out = GetCommandByCombinedIndex(ConsoleCommandNumbers, EditorOnlyConsoleCommandNumbers, ArrayIndex);
 #else
 	const auto& Commands = ConsoleCommandNumbers;
 	if (!Commands.IsValidIndex(ArrayIndex))
@@ -244,10 +271,7 @@ bool UGDMConsoleCommandSetAsset::GetConsoleCommandNumberByArrayIndex(const int32
 int32 UGDMConsoleCommandSetAsset::GetNumConsoleCommandNumbers() const
 {
 #if WITH_EDITOR
-	TArray<FGDMConsoleCommandNumber> Commands;
-	Commands.Append(ConsoleCommandNumbers);
-	Commands.Append(EditorOnlyConsoleCommandNumbers);
-	return Commands.Num();
+	return ConsoleCommandNumbers.Num() + EditorOnlyConsoleCommandNumbers.Num();
 #else
 	return ConsoleCommandNumbers.Num();
 #endif
@@ -255,100 +279,139 @@ int32 UGDMConsoleCommandSetAsset::GetNumConsoleCommandNumbers() const
 
 bool UGDMConsoleCommandSetAsset::FindConsoleCommandSingleById(const FString& CommandId, FGDMConsoleCommandSingle& Out) const
 {
-	for (const FGDMConsoleCommandSingle& Cmd : ConsoleCommandNames)
+	if (const FCommandIndexEntry* Entry = FindCommandIndexEntry(CommandId, EGDMConsoleCommandType::Single))
 	{
-		if (Cmd.BuildCommandIdentifier() == CommandId)
-		{
-			Out = Cmd;
-			return true;
-		}
+		Out = GetCommandByCombinedIndex(ConsoleCommandNames, EditorOnlyConsoleCommandNames, Entry->ArrayIndex);
+		return true;
 	}
 
-#if WITH_EDITOR
-	for (const FGDMConsoleCommandSingle& Cmd : EditorOnlyConsoleCommandNames)
+	return false;
+}
+
+bool UGDMConsoleCommandSetAsset::FindConsoleCommandGroupById(const FString& CommandId, FGDMConsoleCommandGroup& Out) const
+{
+	if (const FCommandIndexEntry* Entry = FindCommandIndexEntry(CommandId, EGDMConsoleCommandType::Group))
 	{
-		if (Cmd.BuildCommandIdentifier() == CommandId)
-		{
-			Out = Cmd;
-			return true;
-		}
+		Out = GetCommandByCombinedIndex(ConsoleCommandGroups, EditorOnlyConsoleCommandGroups, Entry->ArrayIndex);
+		return true;
 	}
-#endif
 
 	return false;
 }
 
-bool UGDMConsoleCommandSetAsset::FindConsoleCommandGroupById(const FString& CommandId, FGDMConsoleCommandGroup& Out) const
+bool UGDMConsoleCommandSetAsset::FindConsoleCommandPairById(const FString& CommandId, FGDMConsoleCommandPair& Out) const
 {
-	for (const FGDMConsoleCommandGroup& Cmd : ConsoleCommandGroups)
+	if (const FCommandIndexEntry* Entry = FindCommandIndexEntry(CommandId, EGDMConsoleCommandType::Pair))
 	{
-		if (Cmd.BuildCommandIdentifier() == CommandId)
-		{
-			Out = Cmd;
-			return true;
-		}
+		Out = GetCommandByCombinedIndex(ConsoleCommandPairs, EditorOnlyConsoleCommandPairs, Entry->ArrayIndex);
+		return true;
 	}
 
-#if WITH_EDITOR
-	for (const FGDMConsoleCommandGroup& Cmd : EditorOnlyConsoleCommandGroups)
+	return false;
+}
+
+bool UGDMConsoleCommandSetAsset::FindConsoleCommandNumberById(const FString& CommandId, FGDMConsoleCommandNumber& Out) const
+{
+	if (const FCommandIndexEntry* Entry = FindCommandIndexEntry(CommandId, EGDMConsoleCommandType::Number))
 	{
-		if (Cmd.BuildCommandIdentifier() == CommandId)
-		{
-			Out = Cmd;
-			return true;
-		}
+		Out = GetCommandByCombinedIndex(ConsoleCommandNumbers, EditorOnlyConsoleCommandNumbers, Entry->ArrayIndex);
+		return true;
 	}
-#endif
 
 	return false;
 }
 
-bool UGDMConsoleCommandSetAsset::FindConsoleCommandPairById(const FString& CommandId, FGDMConsoleCommandPair& Out) const
+void UGDMConsoleCommandSetAsset::SearchConsoleCommands(const FString& Query, int32 MaxResults, TArray<FGDMConsoleCommandSearchResult>& OutResults) const
 {
-	for (const FGDMConsoleCommandPair& Cmd : ConsoleCommandPairs)
+	if (!SearchIndex.IsUpToDate())
 	{
-		if (Cmd.BuildCommandIdentifier() == CommandId)
-		{
-			Out = Cmd;
-			return true;
-		}
+		SearchIndex.Build(*this);
 	}
 
+	SearchIndex.Search(Query, MaxResults, OutResults);
+}
+
+void UGDMConsoleCommandSetAsset::PostLoad()
+{
+	Super::PostLoad();
+
+	MarkCommandIndexDirty();
+	RebuildCommandIdentifierIndex();
+}
+
 #if WITH_EDITOR
-	for (const FGDMConsoleCommandPair& Cmd : EditorOnlyConsoleCommandPairs)
-	{
-		if (Cmd.BuildCommandIdentifier() == CommandId)
-		{
-			Out = Cmd;
-			return true;
-		}
-	}
+void UGDMConsoleCommandSetAsset::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+
+	MarkCommandIndexDirty();
+}
+
+void UGDMConsoleCommandSetAsset::PostEditUndo()
+{
+	Super::PostEditUndo();
+
+	MarkCommandIndexDirty();
+}
 #endif
 
-	return false;
+void UGDMConsoleCommandSetAsset::MarkCommandIndexDirty()
+{
+	bCommandIdentifierIndexDirty = true;
+	SearchIndex.Reset();
 }
 
-bool UGDMConsoleCommandSetAsset::FindConsoleCommandNumberById(const FString& CommandId, FGDMConsoleCommandNumber& Out) const
+void UGDMConsoleCommandSetAsset::RebuildCommandIdentifierIndex() const
 {
-	for (const FGDMConsoleCommandNumber& Cmd : ConsoleCommandNumbers)
+	CommandIdentifierIndex.Reset();
+
+	auto AddCommands = [this](const auto& Commands, const auto& EditorOnlyCommands, EGDMConsoleCommandType Type)
 	{
-		if (Cmd.BuildCommandIdentifier() == CommandId)
+		auto AddCommand = [this, Type](const auto& Command, int32 ArrayIndex)
 		{
-			Out = Cmd;
-			return true;
+			/* 同じ識別子は先に見つかったものを優先（以前の線形検索と同じ結果にする） */
+			const FString Identifier = Command.BuildCommandIdentifier();
+			if (!CommandIdentifierIndex.Contains(Identifier))
+			{
+				CommandIdentifierIndex.Add(Identifier, FCommandIndexEntry{ Type, ArrayIndex });
+			}
+		};
+
+		int32 ArrayIndex = 0;
+		for (const auto& Command : Commands)
+		{
+			AddCommand(Command, ArrayIndex++);
 		}
-	}
 
 #if WITH_EDITOR
-	for (const FGDMConsoleCommandNumber& Cmd : EditorOnlyConsoleCommandNumbers)
-	{
-		if (Cmd.BuildCommandIdentifier() == CommandId)
+		for (const auto& Command : EditorOnlyCommands)
 		{
-			Out = Cmd;
-			return true;
+			AddCommand(Command, ArrayIndex++);
 		}
-	}
 #endif
+	};
 
-	return false;
+	CommandIdentifierIndex.Reserve(ConsoleCommandNames.Num() + ConsoleCommandGroups.Num() + ConsoleCommandPairs.Num() + ConsoleCommandNumbers.Num());
+	AddCommands(ConsoleCommandNames, EditorOnlyConsoleCommandNames, EGDMConsoleCommandType::Single);
+	AddCommands(ConsoleCommandGroups, EditorOnlyConsoleCommandGroups, EGDMConsoleCommandType::Group);
+	AddCommands(ConsoleCommandPairs, EditorOnlyConsoleCommandPairs, EGDMConsoleCommandType::Pair);
+	AddCommands(ConsoleCommandNumbers, EditorOnlyConsoleCommandNumbers, EGDMConsoleCommandType::Number);
+
+	bCommandIdentifierIndexDirty = false;
+}
+
+const UGDMConsoleCommandSetAsset::FCommandIndexEntry* UGDMConsoleCommandSetAsset::FindCommandIndexEntry(const FString& CommandId, EGDMConsoleCommandType Type) const
+{
+	if (bCommandIdentifierIndexDirty)
+	{
+		RebuildCommandIdentifierIndex();
+	}
+
+	const FCommandIndexEntry* Entry = CommandIdentifierIndex.Find(CommandId);
+	if (Entry == nullptr || Entry->Type != Type)
+	{
+		return nullptr;
+	}
+
+	return Entry;
 }
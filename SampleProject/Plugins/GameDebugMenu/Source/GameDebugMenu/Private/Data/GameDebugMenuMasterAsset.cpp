@@ -14,6 +14,8 @@ UGameDebugMenuMasterAsset::UGameDebugMenuMasterAsset(const FObjectInitializer& O
 	, DebugReportRequesterClass()
 	, GameDebugMenuStringTables()
 	, FontName(nullptr)
+	, ManagerClassIndices()
+	, bManagerClassIndicesBuilt(false)
 {
 }
 
@@ -22,6 +24,16 @@ FPrimaryAssetId UGameDebugMenuMasterAsset::GetPrimaryAssetId() const
 	return FPrimaryAssetId(GetPrimaryType(), GetFName());
 }
 
+#if WITH_EDITOR
+void UGameDebugMenuMasterAsset::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+
+	/* クラスの一覧が変わった可能性があるので作り直す */
+	bManagerClassIndicesBuilt = false;
+}
+#endif
+
 const FPrimaryAssetType& UGameDebugMenuMasterAsset::GetPrimaryType()
 {
 	static const FPrimaryAssetType AssetType = TEXT("GameDebugMenuMaster");
@@ -30,8 +42,28 @@ const FPrimaryAssetType& UGameDebugMenuMasterAsset::GetPrimaryType()
 
 TSoftClassPtr<AGameDebugMenuManager> UGameDebugMenuMasterAsset::GetGameDebugMenuManagerSoftClass(FString ClassName) const
 {
-	for (const TSoftClassPtr<AGameDebugMenuManager>& ClassPtr : DebugMenuManagerClasses)
+	if (!bManagerClassIndicesBuilt)
+	{
+		BuildManagerClassIndices();
+	}
+
+	const int32* Index = ManagerClassIndices.Find(ClassName);
+	if (Index == nullptr || !DebugMenuManagerClasses.IsValidIndex(*Index))
+	{
+		return nullptr;
+	}
+
+	return DebugMenuManagerClasses[*Index];
+}
+
+void UGameDebugMenuMasterAsset::BuildManagerClassIndices() const
+{
+	ManagerClassIndices.Reset();
+	ManagerClassIndices.Reserve(DebugMenuManagerClasses.Num());
+	
+	for (int32 Index = 0; Index < DebugMenuManagerClasses.Num(); ++Index)
 	{
+		const TSoftClassPtr<AGameDebugMenuManager>& ClassPtr = DebugMenuManagerClasses[Index];
 		if (ClassPtr.IsNull())
 		{
 			continue;
@@ -39,12 +71,13 @@ TSoftClassPtr<AGameDebugMenuManager> UGameDebugMenuMasterAsset::GetGameDebugMenu
 
 		FString AssetName = ClassPtr.GetAssetName();
 		AssetName.RemoveFromEnd(TEXT("_C"));
-		
-		if (AssetName == ClassName)
+
+		/* 同名がある場合は先に登録されている方を使う（大文字小文字は区別しない） */
+		if (!ManagerClassIndices.Contains(AssetName))
 		{
-			return ClassPtr;
+			ManagerClassIndices.Add(MoveTemp(AssetName), Index);
 		}
 	}
 
-	return nullptr;
+	bManagerClassIndicesBuilt = true;
 }
@@ -53,14 +53,27 @@ AGameDebugMenuManager::AGameDebugMenuManager(const FObjectInitializer& ObjectIni
 	, ConsoleCommandSetAsset(nullptr)
 	, bShowDebugMenu(false)
 	, bCachedGamePaused(false)
+	, ShowDebugMenuTime(0.0)
 	, bCachedShowMouseCursor(false)
 	, bWaitToCaptureBeforeOpeningDebugReportMenu(false)
 	, CachedNavigationConfigs()
 	, ObjectProperties()
 	, ObjectFunctions()
+	, bDeferSortObjects(false)
 	, DebugMenuRootWidget(nullptr)
 	, DebugMenuInstances()
+	, DebugMenuInstanceKeys()
+	, ViewportDebugMenuWidgets()
+	, RegisteredTextBlocks()
+	, RegisteredDebugMenuWidgets()
 	, OutputLog(nullptr)
+	, ConsoleCommandQueue()
+	, ConsoleCommandQueueHead(0)
+	, LastConsoleCommandRequestId(0)
+	, bProcessingConsoleCommandQueue(false)
+	, ConsoleCommandBudgetFrame(0)
+	, ConsoleCommandBudgetEndTime(0.0)
+	, bExecutedConsoleCommandInBudgetFrame(false)
 {
 	DebugMenuInputSystemComponent = CreateDefaultSubobject<UGDMInputSystemComponent>(TEXT("DebugMenuInputSystemComponent"));
 	ScreenshotRequesterComponent  = CreateDefaultSubobject<UGDMScreenshotRequesterComponent>(TEXT("ScreenshotRequesterComponent"));
@@ -97,60 +110,80 @@ void AGameDebugMenuManager::BeginPlay()
 	}
 
 	/* BeginPlay時点でOwnerが未確定なケースがある（レプリケーション生成など）
-	 * Ownerが確定して「ローカルPCのManager」であることが分かったときだけ初期化する。*/
-	auto TryLocalInit = [this]()
+	 * その場合はOwnerが確定したとき（SetOwner / OnRep_Owner）に改めて判定する */
+	TryLocalBeginPlayInitialize();
+}
+
+void AGameDebugMenuManager::SetOwner(AActor* NewOwner)
+{
+	Super::SetOwner(NewOwner);
+
+	if (HasActorBegunPlay() && !UKismetSystemLibrary::IsDedicatedServer(this))
 	{
-		if (bLocalBeginPlayInitialized)
-		{
-			return;
-		}
+		TryLocalBeginPlayInitialize();
+	}
+}
 
-		const APlayerController* PC = Cast<APlayerController>(GetOwner());
-		if (!IsValid(PC))
-		{
-			return; /* まだOwner未確定、後で再試行 */
-		}
-		
-		if (!PC->IsLocalController())
-		{
-			/* Ownerが確定していてローカルでないなら、このManagerはこのプロセスでは初期化しない */
-			bLocalBeginPlayInitialized = true;
-			return;
-		}
+void AGameDebugMenuManager::OnRep_Owner()
+{
+	Super::OnRep_Owner();
 
+	if (HasActorBegunPlay() && !UKismetSystemLibrary::IsDedicatedServer(this))
+	{
+		TryLocalBeginPlayInitialize();
+	}
+}
+
+void AGameDebugMenuManager::TryLocalBeginPlayInitialize()
+{
+	if (bLocalBeginPlayInitialized)
+	{
+		return;
+	}
+
+	const APlayerController* PC = Cast<APlayerController>(GetOwner());
+	if (!IsValid(PC))
+	{
+		return; /* まだOwner未確定、確定時に再度呼ばれる */
+	}
+	
+	if (!PC->IsLocalController())
+	{
+		/* Ownerが確定していてローカルでないなら、このManagerはこのプロセスでは初期化しない */
 		bLocalBeginPlayInitialized = true;
+		return;
+	}
 
-		OutputLog = MakeShared<FGDMOutputDevice>();
+	bLocalBeginPlayInitialized = true;
 
-		/* 他で参照される前にロードは処理しとく */
-		GetSaveSystemComponent()->LoadDebugMenuFile();
+	OutputLog = MakeShared<FGDMOutputDevice>();
 
-		UGameDebugMenuFunctions::RegisterGameDebugMenuManagerInstance(this);
-		UGameDebugMenuFunctions::PrintLogScreen(this, TEXT("AGameDebugMenuManager: Call BeginPlay"), 4.0f);
+	/* 他で参照される前にロードは処理しとく */
+	GetSaveSystemComponent()->LoadDebugMenuFile();
 
-		/* managerのBeginplayがちゃんと完了後に処理↓ */
-		GetWorld()->GetTimerManager().SetTimer(InitializeManagerHandle, FTimerDelegate::CreateLambda([this]()
-		{
-			OnInitializeManager();
-		}), 0.01f, true);
-	};
+	UGameDebugMenuFunctions::RegisterGameDebugMenuManagerInstance(this);
+	UGameDebugMenuFunctions::PrintLogScreen(this, TEXT("AGameDebugMenuManager: Call BeginPlay"), 4.0f);
 
-	TryLocalInit();
+	/* managerのBeginplayがちゃんと完了後に処理↓（ワールドのBeginPlay中ならその完了後） */
+	UWorld* World = GetWorld();
+	if (World->HasBegunPlay())
+	{
+		InitializeManagerHandle = World->GetTimerManager().SetTimerForNextTick(FTimerDelegate::CreateUObject(this, &AGameDebugMenuManager::OnInitializeManager));
+	}
+	else
+	{
+		World->OnWorldBeginPlay.AddUObject(this, &AGameDebugMenuManager::HandleWorldBeginPlay);
+	}
+}
 
-	/* Owner未確定なら短時間だけリトライ（Ownerが確定したら止まる） */
-	if (!bLocalBeginPlayInitialized)
+void AGameDebugMenuManager::HandleWorldBeginPlay()
+{
+	if (UWorld* World = GetWorld())
 	{
-		GetWorld()->GetTimerManager().SetTimer(LocalBeginPlayRetryHandle, FTimerDelegate::CreateLambda([this, TryLocalInit]()
-		{
-			TryLocalInit();
-			
-			if (bLocalBeginPlayInitialized)
-			{
-				GetWorld()->GetTimerManager().ClearTimer(LocalBeginPlayRetryHandle);
-			}
-			
-		}), 0.1f, true);
+		World->OnWorldBeginPlay.RemoveAll(this);
 	}
+
+	OnInitializeManager();
 }
 
 void AGameDebugMenuManager::EndPlay(const EEndPlayReason::Type EndPlayReason)
@@ -161,9 +194,10 @@ void AGameDebugMenuManager::EndPlay(const EEndPlayReason::Type EndPlayReason)
 
 	if(EndPlayReason != EEndPlayReason::EndPlayInEditor && EndPlayReason != EEndPlayReason::Quit)
 	{
-		if (const UWorld* World = GetWorld())
+		if (UWorld* World = GetWorld())
 		{
 			World->GetTimerManager().ClearTimer(InitializeManagerHandle);
+			World->OnWorldBeginPlay.RemoveAll(this);
 		}
 		
 		EnabledNavigationConfigs();
@@ -186,6 +220,13 @@ void AGameDebugMenuManager::Tick(float DeltaTime)
 	DeltaTime /= GetWorldSettings()->GetEffectiveTimeDilation();
 
 	Super::Tick(DeltaTime);
+
+	if (bPendingInitializeManager)
+	{
+		OnInitializeManager();
+	}
+
+	ProcessConsoleCommandQueue();
 }
 
 UGDMInputSystemComponent* AGameDebugMenuManager::GetDebugMenuInputSystemComponent() const
@@ -235,6 +276,8 @@ bool AGameDebugMenuManager::IsInitializedManager() const
 
 void AGameDebugMenuManager::OnInitializeManager()
 {
+	bPendingInitializeManager = false;
+
 	if (bInitializedManager)
 	{
 		UGameDebugMenuFunctions::PrintLogScreen(this, TEXT("AGameDebugMenuManager: The manager has already been initialized"), 0.6f);
@@ -258,7 +301,9 @@ void AGameDebugMenuManager::OnInitializeManager()
 	{
 		if (PC->IsLocalController())
 		{
+			/* LocalPlayerの設定には通知が無いので次のTickで再度確認する */
 			UGameDebugMenuFunctions::PrintLogScreen(this, TEXT("AGameDebugMenuManager: No LocalPlayer"), 0.6f);
+			bPendingInitializeManager = true;
 			return;
 		}
 	}
@@ -266,6 +311,7 @@ void AGameDebugMenuManager::OnInitializeManager()
 	/* BP側の準備完了を待つ（例：必要なアセットロード待ちなど） */
 	if (!IsReadyToInitializeManager())
 	{
+		bPendingInitializeManager = true;
 		return;
 	}
 
@@ -314,14 +360,13 @@ void AGameDebugMenuManager::OnInitializeManager()
 		}
 	}
 	
-	TArray<FString> CommandHistory = GetPropertyJsonSystemComponent()->GetCustomStringArray(TEXT("CommandHistory"));
-	for(const auto& Command : CommandHistory )
+	/* 保存されていたコマンドはキューでまとめて実行する（多い場合は複数フレームに分かれる） */
+	const TArray<FString> CommandHistory = GetPropertyJsonSystemComponent()->GetCustomStringArray(TEXT("CommandHistory"));
+	if (CommandHistory.Num() > 0)
 	{
-		PC->ConsoleCommand(Command);
+		EnqueueConsoleCommands(CommandHistory, PC);
 	}
 
-	GetWorld()->GetTimerManager().ClearTimer(InitializeManagerHandle);
-
 	EnableInput(PC);
 
 	OnInitializeManagerBP();
@@ -488,6 +533,106 @@ void AGameDebugMenuManager::ExecuteConsoleCommand(const FString& Command, APlaye
 	CallExecuteConsoleCommandDispatcher(Command);
 }
 
+int32 AGameDebugMenuManager::EnqueueConsoleCommands(const TArray<FString>& Commands, APlayerController* PC)
+{
+	FQueuedConsoleCommands& Queued = ConsoleCommandQueue.AddDefaulted_GetRef();
+	Queued.RequestId        = ++LastConsoleCommandRequestId;
+	Queued.Commands         = Commands;
+	Queued.NextIndex        = 0;
+	Queued.PlayerController = PC;
+
+	const int32 RequestId = Queued.RequestId;
+
+	/* 待ちが無ければこのフレームの予算内で実行を始める */
+	if (GetNumQueuedConsoleCommands() == 1)
+	{
+		ProcessConsoleCommandQueue();
+	}
+
+	return RequestId;
+}
+
+int32 AGameDebugMenuManager::EnqueueConsoleCommand(const FString& Command, APlayerController* PC)
+{
+	if (Command.IsEmpty())
+	{
+		return INDEX_NONE;
+	}
+
+	/* 単発でも完了を待てるように個別のIDを振る */
+	return EnqueueConsoleCommands({ Command }, PC);
+}
+
+bool AGameDebugMenuManager::HasQueuedConsoleCommands() const
+{
+	return GetNumQueuedConsoleCommands() > 0;
+}
+
+int32 AGameDebugMenuManager::GetNumQueuedConsoleCommands() const
+{
+	return ConsoleCommandQueue.Num() - ConsoleCommandQueueHead;
+}
+
+void AGameDebugMenuManager::ProcessConsoleCommandQueue()
+{
+	/* コマンド実行中に追加された場合は呼び出し元のループで処理する */
+	if (bProcessingConsoleCommandQueue || GetNumQueuedConsoleCommands() <= 0)
+	{
+		return;
+	}
+
+	TGuardValue<bool> ProcessingGuard(bProcessingConsoleCommandQueue, true);
+
+	/* 予算はフレーム単位。同じフレームでTick以外から呼ばれた場合は残りの予算で実行する */
+	const float BudgetMs = GetDefault<UGameDebugMenuSettings>()->ConsoleCommandFrameBudgetMs;
+	if (ConsoleCommandBudgetFrame != GFrameCounter)
+	{
+		ConsoleCommandBudgetFrame = GFrameCounter;
+		ConsoleCommandBudgetEndTime = FPlatformTime::Seconds() + BudgetMs / 1000.0;
+		bExecutedConsoleCommandInBudgetFrame = false;
+	}
+
+	/* 予算を超えていても1フレームに最低1コマンドは実行して必ず進める */
+	while (GetNumQueuedConsoleCommands() > 0)
+	{
+		FQueuedConsoleCommands& Front = ConsoleCommandQueue[ConsoleCommandQueueHead];
+		if (Front.NextIndex >= Front.Commands.Num())
+		{
+			const int32 RequestId = Front.RequestId;
+
+			/* 先頭を進めるだけにして、空になったか実行済みが半分を超えたら詰める */
+			Front.Commands.Empty();
+			Front.PlayerController.Reset();
+			++ConsoleCommandQueueHead;
+			if (ConsoleCommandQueueHead >= ConsoleCommandQueue.Num())
+			{
+				ConsoleCommandQueue.Reset();
+				ConsoleCommandQueueHead = 0;
+			}
+			else if (ConsoleCommandQueueHead * 2 >= ConsoleCommandQueue.Num())
+			{
+				ConsoleCommandQueue.RemoveAt(0, ConsoleCommandQueueHead, EAllowShrinking::No);
+				ConsoleCommandQueueHead = 0;
+			}
+
+			CallExecutedConsoleCommandsDispatcher(RequestId);
+			continue;
+		}
+
+		if (bExecutedConsoleCommandInBudgetFrame && BudgetMs > 0.0f && FPlatformTime::Seconds() >= ConsoleCommandBudgetEndTime)
+		{
+			break;
+		}
+
+		/* 実行中にキューが追加されると参照が無効になるのでコピーしておく */
+		const FString Command = Front.Commands[Front.NextIndex++];
+		APlayerController* PC = Front.PlayerController.Get();
+
+		ExecuteConsoleCommand(Command, PC);
+		bExecutedConsoleCommandInBudgetFrame = true;
+	}
+}
+
 bool AGameDebugMenuManager::ShowDebugMenu(bool bWaitToCaptureBeforeOpeningMenuFlag)
 {
 	if(bShowDebugMenu)
@@ -510,6 +655,7 @@ bool AGameDebugMenuManager::ShowDebugMenu(bool bWaitToCaptureBeforeOpeningMenuFl
 	}
 
 	bShowDebugMenu = true;
+	ShowDebugMenuTime = FPlatformTime::Seconds();
 
 	APlayerController* PC = GetOwnerPlayerController();
 	DisabledNavigationConfigs();
@@ -662,17 +808,52 @@ TSubclassOf<UGameDebugMenuWidget> AGameDebugMenuManager::GetDebugMenuWidgetClass
 
 FString AGameDebugMenuManager::GetDebugMenuWidgetKey(const UGameDebugMenuWidget* Widget)
 {
-	for (const auto& Pair : DebugMenuInstances)
+	if (!IsValid(Widget))
+	{
+		return TEXT("");
+	}
+
+	if (DebugMenuInstanceKeys.Num() != DebugMenuInstances.Num())
 	{
-		if( Pair.Value == Widget )
+		RebuildDebugMenuInstanceKeys();
+	}
+
+	if (const FString* Key = DebugMenuInstanceKeys.Find(Widget))
+	{
+		/* BP側で同じキーのWidgetが差し替えられていないか正引きで確認 */
+		const TObjectPtr<UGameDebugMenuWidget>* Instance = DebugMenuInstances.Find(*Key);
+		if (Instance != nullptr && *Instance == Widget)
 		{
-			return Pair.Key;
+			return *Key;
 		}
 	}
 
+	/* 見つからない場合も件数を変えずに差し替えられた可能性があるので、作り直して引き直す */
+	RebuildDebugMenuInstanceKeys();
+	if (const FString* RebuiltKey = DebugMenuInstanceKeys.Find(Widget))
+	{
+		return *RebuiltKey;
+	}
+
 	return TEXT("");
 }
 
+void AGameDebugMenuManager::RebuildDebugMenuInstanceKeys()
+{
+	DebugMenuInstanceKeys.Reset();
+	DebugMenuInstanceKeys.Reserve(DebugMenuInstances.Num());
+	
+	for (const auto& Pair : DebugMenuInstances)
+	{
+		/* 同じWidgetが複数のキーにある場合は最初のキーを返していたので合わせる */
+		const UGameDebugMenuWidget* Widget = Pair.Value.Get();
+		if (!DebugMenuInstanceKeys.Contains(Widget))
+		{
+			DebugMenuInstanceKeys.Add(Widget, Pair.Key);
+		}
+	}
+}
+
 bool AGameDebugMenuManager::GetDebugMenuWidgetInstances(TArray<UGameDebugMenuWidget*>& OutInstances)
 {
 	TArray<TObjectPtr<UGameDebugMenuWidget>> Array; 
@@ -694,6 +875,51 @@ void AGameDebugMenuManager::GetOutputLogString(FString& OutLog, const FString& S
 	OutLog = UKismetStringLibrary::JoinStringArray(OutputLog->GetLogs(), Separator);
 }
 
+void AGameDebugMenuManager::GetOutputLogStringInTimeRange(FString& OutLog, const FString& Separator, double StartTime, double EndTime)
+{
+	OutLog = UKismetStringLibrary::JoinStringArray(OutputLog->GetLogsInTimeRange(StartTime, EndTime), Separator);
+}
+
+void AGameDebugMenuManager::GetOutputLogStringInFrameRange(FString& OutLog, const FString& Separator, uint64 StartFrame, uint64 EndFrame)
+{
+	OutLog = UKismetStringLibrary::JoinStringArray(OutputLog->GetLogsInFrameRange(StartFrame, EndFrame), Separator);
+}
+
+void AGameDebugMenuManager::ExportOutputLogAsync(const FString& FileName, bool bCompress)
+{
+	if (!OutputLog.IsValid())
+	{
+		UE_LOG(LogGDM, Warning, TEXT("ExportOutputLogAsync: Not found OutputLog"));
+		CallExportedOutputLogDispatcher(false, FString());
+		return;
+	}
+
+	const FString Extension = bCompress ? TEXT(".log.gz") : TEXT(".log");
+	const FString FilePath = FPaths::ProjectDir() / GetDefault<UGameDebugMenuSettings>()->SaveFilePath / (FileName + Extension);
+
+	TWeakObjectPtr<AGameDebugMenuManager> WeakThis(this);
+	OutputLog->ExportLogsAsync(FilePath, bCompress,
+		FGDMOnLogExportProgress::CreateLambda([WeakThis](float Progress)
+		{
+			if (WeakThis.IsValid())
+			{
+				WeakThis->CallExportOutputLogProgressDispatcher(Progress);
+			}
+		}),
+		FGDMOnLogExportCompleted::CreateLambda([WeakThis](bool bSuccess, const FString& ExportedFilePath)
+		{
+			if (WeakThis.IsValid())
+			{
+				WeakThis->CallExportedOutputLogDispatcher(bSuccess, ExportedFilePath);
+			}
+		}));
+}
+
+double AGameDebugMenuManager::GetShowDebugMenuTime() const
+{
+	return ShowDebugMenuTime;
+}
+
 void AGameDebugMenuManager::GetOutputCommandHistoryString(TArray<FString>& OutCommandHistory)
 {
 	OutCommandHistory = OutputLog->GetCommandHistory();
@@ -866,10 +1092,10 @@ bool AGameDebugMenuManager::RegisterObjectProperty(UObject* TargetObject, const
 
 	ObjectProperties.Add(PropertyInfo);
 
-	ObjectProperties.Sort([](const TSharedPtr<FGDMObjectPropertyInfo>& A,const TSharedPtr<FGDMObjectPropertyInfo>& B)
+	if (!bDeferSortObjects)
 	{
-		return A->DisplayPriority >= B->DisplayPriority;
-	});
+		SortObjectProperties();
+	}
 	
 	if (!PropertySaveKey.IsEmpty())
 	{
@@ -953,10 +1179,10 @@ bool AGameDebugMenuManager::RegisterObjectFunction(UObject* TargetObject, const
 	
 	ObjectFunctions.Add(FunctionInfo);
 
-	ObjectFunctions.Sort([](const TSharedPtr<FGDMObjectFunctionInfo>& A,const TSharedPtr<FGDMObjectFunctionInfo>& B)
+	if (!bDeferSortObjects)
 	{
-		return A->DisplayPriority >= B->DisplayPriority;
-	});
+		SortObjectFunctions();
+	}
 
 	if (!FunctionSaveKey.IsEmpty())
 	{
@@ -971,6 +1197,71 @@ bool AGameDebugMenuManager::RegisterObjectFunction(UObject* TargetObject, const
 	return true;
 }
 
+void AGameDebugMenuManager::RegisterPendingObjects(const FGDMPendingObjectQueue& PendingQueue)
+{
+	if (PendingQueue.Properties.Num() <= 0 && PendingQueue.Functions.Num() <= 0)
+	{
+		return;
+	}
+
+	{
+		TGuardValue<bool> DeferSortGuard(bDeferSortObjects, true);
+
+		for (const FGDMPendingObjectData& PendingData : PendingQueue.Properties)
+		{
+			/* 登録待ちの間に破棄されたものは除外 */
+			if (PendingData.TargetObject.IsValid())
+			{
+				RegisterObjectProperty(PendingData.TargetObject.Get(),
+									   PendingData.TargetName,
+									   PendingData.CategoryKey,
+									   PendingData.SaveKey,
+									   PendingData.DisplayPropertyName,
+									   PendingData.Description,
+									   PendingData.ConfigInfo,
+									   PendingData.DisplayPriority
+				);
+			}
+		}
+
+		for (const FGDMPendingObjectData& PendingData : PendingQueue.Functions)
+		{
+			if (PendingData.TargetObject.IsValid())
+			{
+				RegisterObjectFunction(PendingData.TargetObject.Get(),
+									   PendingData.TargetName,
+									   PendingData.CategoryKey,
+									   PendingData.SaveKey,
+									   PendingData.DisplayPropertyName,
+									   PendingData.Description,
+									   PendingData.DisplayPriority
+				);
+			}
+		}
+	}
+
+	SortObjectProperties();
+	SortObjectFunctions();
+
+	UE_LOG(LogGDM, Log, TEXT("RegisterPendingObjects: Properties %d, Functions %d"), PendingQueue.Properties.Num(), PendingQueue.Functions.Num());
+}
+
+void AGameDebugMenuManager::SortObjectProperties()
+{
+	ObjectProperties.Sort([](const TSharedPtr<FGDMObjectPropertyInfo>& A,const TSharedPtr<FGDMObjectPropertyInfo>& B)
+	{
+		return A->DisplayPriority >= B->DisplayPriority;
+	});
+}
+
+void AGameDebugMenuManager::SortObjectFunctions()
+{
+	ObjectFunctions.Sort([](const TSharedPtr<FGDMObjectFunctionInfo>& A,const TSharedPtr<FGDMObjectFunctionInfo>& B)
+	{
+		return A->DisplayPriority >= B->DisplayPriority;
+	});
+}
+
 UObject* AGameDebugMenuManager::GetObjectProperty(const int32 Index, FGDMGameplayCategoryKey& OutCategoryKey, FString& OutPropertySaveKey, FText& OutDisplayPropertyName, FText& OutDescription, FName& OutPropertyName, EGDMPropertyType& OutPropertyType, FString& OutEnumPathName, FGDMPropertyUIConfigInfo& OutPropertyUIConfigInfo)
 {
 	OutPropertyType = EGDMPropertyType::GDM_Null;
@@ -1208,41 +1499,129 @@ void AGameDebugMenuManager::ChangeDebugMenuLanguage(FName LanguageKey, bool bFor
 		GetLocalizeStringComponent()->SyncLoadDebugMenuStringTables();
 	}
 
-	TArray<UWidget*> ChildWidgets;
-	for(const auto& ViewportWidget : ViewportDebugMenuWidgets )
+	/* 登録済みのTextBlockは読み直したテーブルから直接引いて更新する（Widgetツリーは走査しない） */
 	{
-		/* Viewportに追加 Widget 内にあるすべてのTextBlockとDebugMenuWidgetを更新 */
+		UGDMLocalizeStringComponent* LocalizeStringComponent = GetLocalizeStringComponent();
+		FString DebugMenuString;
+		for(const TWeakObjectPtr<UGDMTextBlock>& WeakTextBlock : RegisteredTextBlocks )
 		{
-			ViewportWidget->GetWidgetChildrenOfClass(UGDMTextBlock::StaticClass(), ChildWidgets, false);
-
-			for(const auto ChildWidget : ChildWidgets )
+			UGDMTextBlock* TextBlock = WeakTextBlock.Get();
+			if( IsValid(TextBlock) && !TextBlock->DebugMenuStringKey.IsEmpty() )
 			{
-				if( UGDMTextBlock* TextBlock = Cast<UGDMTextBlock>(ChildWidget) )
-				{
-					if( !TextBlock->DebugMenuStringKey.IsEmpty() )
-					{
-						TextBlock->SetText(FText::FromString(TextBlock->DebugMenuStringKey));
-					}
-				}
+				LocalizeStringComponent->GetString(TextBlock->DebugMenuStringKey, DebugMenuString);
+				TextBlock->SetResolvedDebugMenuString(DebugMenuString);
 			}
+		}
+	}
 
-			ViewportWidget->GetWidgetChildrenOfClass(UGameDebugMenuWidget::StaticClass(), ChildWidgets, false);
-
-			for(const auto ChildWidget : ChildWidgets )
-			{
-				if( UGameDebugMenuWidget* DebugMenuWidget = Cast<UGameDebugMenuWidget>(ChildWidget) )
-				{
-					DebugMenuWidget->OnChangeDebugMenuLanguage(LanguageKey, Old);
-				}
-			}
+	/* 登録済みのDebugMenuWidgetに通知する。Viewportに追加したWidgetは中身の後に通知するのでここでは飛ばす
+	 * （通知先でWidgetが生成/破棄されて配列が変わることがあるので複製してから回す） */
+	const TArray<TWeakObjectPtr<UGameDebugMenuWidget>> DebugMenuWidgets = RegisteredDebugMenuWidgets;
+	for(const TWeakObjectPtr<UGameDebugMenuWidget>& WeakDebugMenuWidget : DebugMenuWidgets )
+	{
+		UGameDebugMenuWidget* DebugMenuWidget = WeakDebugMenuWidget.Get();
+		if( IsValid(DebugMenuWidget) && !ViewportDebugMenuWidgets.Contains(DebugMenuWidget) )
+		{
+			DebugMenuWidget->OnChangeDebugMenuLanguage(LanguageKey, Old);
 		}
+	}
 
+	for(const auto& ViewportWidget : ViewportDebugMenuWidgets )
+	{
 		ViewportWidget->OnChangeDebugMenuLanguage(LanguageKey, Old);
 	}
 
 	CallChangeDebugMenuLanguageDispatcher(LanguageKey, Old);
 }
 
+void AGameDebugMenuManager::RegisterDebugMenuTextBlock(UGDMTextBlock* TextBlock)
+{
+	if( !IsValid(TextBlock) || TextBlock->RegisteredManager.Get() == this )
+	{
+		return;
+	}
+
+	TextBlock->RegisteredManager = this;
+	TextBlock->RegisteredIndex   = RegisteredTextBlocks.Add(TextBlock);
+}
+
+void AGameDebugMenuManager::UnregisterDebugMenuTextBlock(UGDMTextBlock* TextBlock)
+{
+	if( TextBlock == nullptr || TextBlock->RegisteredManager.GetEvenIfUnreachable() != this )
+	{
+		return;
+	}
+
+	/* 破棄中のTextBlockでも比較できるようにキー同士で比べる */
+	const TWeakObjectPtr<UGDMTextBlock> Key(TextBlock);
+	int32 Index = TextBlock->RegisteredIndex;
+	if( !RegisteredTextBlocks.IsValidIndex(Index) || RegisteredTextBlocks[Index] != Key )
+	{
+		Index = RegisteredTextBlocks.IndexOfByKey(Key);
+	}
+
+	TextBlock->RegisteredManager.Reset();
+	TextBlock->RegisteredIndex = INDEX_NONE;
+
+	if( Index == INDEX_NONE )
+	{
+		return;
+	}
+
+	RegisteredTextBlocks.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	if( RegisteredTextBlocks.IsValidIndex(Index) )
+	{
+		if( UGDMTextBlock* MovedTextBlock = RegisteredTextBlocks[Index].GetEvenIfUnreachable() )
+		{
+			MovedTextBlock->RegisteredIndex = Index;
+		}
+	}
+}
+
+void AGameDebugMenuManager::RegisterDebugMenuWidget(UGameDebugMenuWidget* DebugMenuWidget)
+{
+	if( !IsValid(DebugMenuWidget) || DebugMenuWidget->RegisteredManager.Get() == this )
+	{
+		return;
+	}
+
+	DebugMenuWidget->RegisteredManager = this;
+	DebugMenuWidget->RegisteredIndex   = RegisteredDebugMenuWidgets.Add(DebugMenuWidget);
+}
+
+void AGameDebugMenuManager::UnregisterDebugMenuWidget(UGameDebugMenuWidget* DebugMenuWidget)
+{
+	if( DebugMenuWidget == nullptr || DebugMenuWidget->RegisteredManager.GetEvenIfUnreachable() != this )
+	{
+		return;
+	}
+
+	/* 破棄中のWidgetでも比較できるようにキー同士で比べる */
+	const TWeakObjectPtr<UGameDebugMenuWidget> Key(DebugMenuWidget);
+	int32 Index = DebugMenuWidget->RegisteredIndex;
+	if( !RegisteredDebugMenuWidgets.IsValidIndex(Index) || RegisteredDebugMenuWidgets[Index] != Key )
+	{
+		Index = RegisteredDebugMenuWidgets.IndexOfByKey(Key);
+	}
+
+	DebugMenuWidget->RegisteredManager.Reset();
+	DebugMenuWidget->RegisteredIndex = INDEX_NONE;
+
+	if( Index == INDEX_NONE )
+	{
+		return;
+	}
+
+	RegisteredDebugMenuWidgets.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	if( RegisteredDebugMenuWidgets.IsValidIndex(Index) )
+	{
+		if( UGameDebugMenuWidget* MovedDebugMenuWidget = RegisteredDebugMenuWidgets[Index].GetEvenIfUnreachable() )
+		{
+			MovedDebugMenuWidget->RegisteredIndex = Index;
+		}
+	}
+}
+
 TArray<UGameDebugMenuWidget*> AGameDebugMenuManager::GetViewportDebugMenuWidgets()
 {
 	return ViewportDebugMenuWidgets;
@@ -1505,3 +1884,36 @@ void AGameDebugMenuManager::CallDeletedDebugMenuDispatcher()
 		Component->OnDeletedDebugMenuDispatcher.Broadcast();
 	}
 }
+
+void AGameDebugMenuManager::CallExecutedConsoleCommandsDispatcher(int32 RequestId)
+{
+	TArray<UGDMListenerComponent*> ListenerComponents;
+	UGDMListenerComponent::GetAllListenerComponents(GetWorld(), ListenerComponents);
+
+	for(const auto& Component : ListenerComponents )
+	{
+		Component->OnExecutedConsoleCommandsDispatcher.Broadcast(RequestId);
+	}
+}
+
+void AGameDebugMenuManager::CallExportOutputLogProgressDispatcher(float Progress)
+{
+	TArray<UGDMListenerComponent*> ListenerComponents;
+	UGDMListenerComponent::GetAllListenerComponents(GetWorld(), ListenerComponents);
+
+	for(const auto& Component : ListenerComponents )
+	{
+		Component->OnExportOutputLogProgressDispatcher.Broadcast(Progress);
+	}
+}
+
+void AGameDebugMenuManager::CallExportedOutputLogDispatcher(bool bSuccess, const FString& FilePath)
+{
+	TArray<UGDMListenerComponent*> ListenerComponents;
+	UGDMListenerComponent::GetAllListenerComponents(GetWorld(), ListenerComponents);
+
+	for(const auto& Component : ListenerComponents )
+	{
+		Component->OnExportedOutputLogDispatcher.Broadcast(bSuccess, FilePath);
+	}
+}
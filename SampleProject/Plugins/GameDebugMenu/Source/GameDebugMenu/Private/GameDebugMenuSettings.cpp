@@ -7,6 +7,7 @@
 
 #include "GameDebugMenuSettings.h"
 #include "Performance/EnginePerformanceTargets.h"
+#include "Misc/ConfigCacheIni.h"
 #include <Internationalization/StringTableCore.h>
 
 #include "GameDebugMenuTypes.h"
@@ -22,22 +23,6 @@ UGameDebugMenuSettings::UGameDebugMenuSettings()
 {
 	CategoryName = TEXT("Plugins");
 
-	SetupCategoryResets();
-	SetupCategorySlomo();
-	SetupCategoryCamera();
-	SetupCategoryProfiler();
-	SetupCategoryDisplay();
-	SetupCategoryShowDebug();
-	SetupCategoryViewMode();
-	SetupCategoryScalability();
-	SetupCategoryFreeze();
-	SetupCategoryDumpLogs();
-	SetupCategoryNetwork();
-	SetupCategorySound();
-	SetupCategoryAbilitySystem();
-	SetupCategoryOther();
-	SetupCategoryLogVerbosity();
-
 	MasterAssetName = TEXT("DA_GDM_Master");
 	
 	OrderConsoleCommandCategoryTitles.Add(FGDMOrderMenuCategoryTitle(TEXT("Resets"),0));
@@ -58,6 +43,8 @@ UGameDebugMenuSettings::UGameDebugMenuSettings()
 
 	OrderGameplayCategoryTitles.Add(FGDMOrderMenuCategoryTitle(TEXT("Other"),0));
 
+	ConsoleCommandFrameBudgetMs = 2.0f;
+
 	/* AGameDebugMenuManagerもデフォルトではInt最大値なのでそれより低くする
 	 * 同じ、または大きくした場合、マネージャーで設定する入力はメニューが閉じられるまで反応しなくなるので注意 */
 	WidgetInputActionPriority = TNumericLimits<int32>::Max() - 1;
@@ -68,6 +55,8 @@ UGameDebugMenuSettings::UGameDebugMenuSettings()
 	DefaultGameDebugMenuLanguage = TEXT("Japanese");
 
 	bDisableScreenCaptureProcessingWhenOpeningDebugMenu = true;
+	ReportLogDurationSeconds = 0.0f;
+	bCollapseRepeatedLogLines = false;
 
 	bUseSaveGame = false;
 	SaveFilePath = TEXT("Saved/DebugMenu");
@@ -86,6 +75,7 @@ UGameDebugMenuSettings::UGameDebugMenuSettings()
 	LineBreakString = TEXT("\n");
 	
 	MasterAsset = nullptr;
+	bAppliedDefaultConsoleCommands = false;
 }
 
 #if WITH_EDITOR
@@ -415,7 +405,99 @@ UGameDebugMenuMasterAsset* UGameDebugMenuSettings::GetMasterAsset() const
 	return MasterAsset;
 }
 
-void UGameDebugMenuSettings::SetupCategoryResets()
+bool UGameDebugMenuSettings::IsPropertySetInConfig(const FName& PropertyName) const
+{
+	if( GConfig == nullptr )
+	{
+		return false;
+	}
+
+	const FConfigSection* Section = GConfig->GetSection(*GetClass()->GetPathName(), false, GetClass()->GetConfigName());
+	return (Section != nullptr) && Section->Contains(PropertyName);
+}
+
+bool UGameDebugMenuSettings::ApplyDefaultConsoleCommandsToUnsetArrays()
+{
+	if( !HasAnyFlags(RF_ClassDefaultObject) || bAppliedDefaultConsoleCommands )
+	{
+		return false;
+	}
+
+	bAppliedDefaultConsoleCommands = true;
+
+	/* 以前のコンストラクタでの既定値と同じく、INIで設定した配列だけがINIの内容になる */
+	const FGDMConsoleCommandCatalog& DefaultCatalog = GetDefaultConsoleCommandCatalog();
+	auto ApplyIfUnset = [this](const FName& PropertyName, auto& Commands, const auto& DefaultCommands)
+	{
+		if( !IsPropertySetInConfig(PropertyName) )
+		{
+			Commands = DefaultCommands;
+		}
+	};
+
+	ApplyIfUnset(GET_MEMBER_NAME_CHECKED(UGameDebugMenuSettings, ConsoleCommandNames), ConsoleCommandNames, DefaultCatalog.ConsoleCommandNames);
+	ApplyIfUnset(GET_MEMBER_NAME_CHECKED(UGameDebugMenuSettings, ConsoleCommandGroups), ConsoleCommandGroups, DefaultCatalog.ConsoleCommandGroups);
+	ApplyIfUnset(GET_MEMBER_NAME_CHECKED(UGameDebugMenuSettings, ConsoleCommandPairs), ConsoleCommandPairs, DefaultCatalog.ConsoleCommandPairs);
+	ApplyIfUnset(GET_MEMBER_NAME_CHECKED(UGameDebugMenuSettings, ConsoleCommandNumbers), ConsoleCommandNumbers, DefaultCatalog.ConsoleCommandNumbers);
+	ApplyIfUnset(GET_MEMBER_NAME_CHECKED(UGameDebugMenuSettings, EditorOnlyConsoleCommandNames), EditorOnlyConsoleCommandNames, DefaultCatalog.EditorOnlyConsoleCommandNames);
+	ApplyIfUnset(GET_MEMBER_NAME_CHECKED(UGameDebugMenuSettings, EditorOnlyConsoleCommandGroups), EditorOnlyConsoleCommandGroups, DefaultCatalog.EditorOnlyConsoleCommandGroups);
+	ApplyIfUnset(GET_MEMBER_NAME_CHECKED(UGameDebugMenuSettings, EditorOnlyConsoleCommandPairs), EditorOnlyConsoleCommandPairs, DefaultCatalog.EditorOnlyConsoleCommandPairs);
+	ApplyIfUnset(GET_MEMBER_NAME_CHECKED(UGameDebugMenuSettings, EditorOnlyConsoleCommandNumbers), EditorOnlyConsoleCommandNumbers, DefaultCatalog.EditorOnlyConsoleCommandNumbers);
+	return true;
+}
+
+const FGDMConsoleCommandCatalog& UGameDebugMenuSettings::GetDefaultConsoleCommandCatalog()
+{
+	/* CDO生成時ではなく、初めて必要になった時に一度だけ作成する */
+	static const FGDMConsoleCommandCatalog DefaultCatalog = FGDMConsoleCommandCatalog::CreateDefault();
+	return DefaultCatalog;
+}
+
+void UGameDebugMenuSettings::ResetToDefaultConsoleCommands()
+{
+#if WITH_EDITOR
+	const FGDMConsoleCommandCatalog& DefaultCatalog = GetDefaultConsoleCommandCatalog();
+
+	Modify();
+	ConsoleCommandNames             = DefaultCatalog.ConsoleCommandNames;
+	ConsoleCommandGroups            = DefaultCatalog.ConsoleCommandGroups;
+	ConsoleCommandPairs             = DefaultCatalog.ConsoleCommandPairs;
+	ConsoleCommandNumbers           = DefaultCatalog.ConsoleCommandNumbers;
+	EditorOnlyConsoleCommandNames   = DefaultCatalog.EditorOnlyConsoleCommandNames;
+	EditorOnlyConsoleCommandGroups  = DefaultCatalog.EditorOnlyConsoleCommandGroups;
+	EditorOnlyConsoleCommandPairs   = DefaultCatalog.EditorOnlyConsoleCommandPairs;
+	EditorOnlyConsoleCommandNumbers = DefaultCatalog.EditorOnlyConsoleCommandNumbers;
+	bAppliedDefaultConsoleCommands  = true;
+	TryUpdateDefaultConfigFile();
+#endif
+}
+
+/************************************************************************/
+/* FGDMConsoleCommandCatalog											*/
+/************************************************************************/
+
+FGDMConsoleCommandCatalog FGDMConsoleCommandCatalog::CreateDefault()
+{
+	FGDMConsoleCommandCatalog Catalog;
+	Catalog.SetupCategoryResets();
+	Catalog.SetupCategorySlomo();
+	Catalog.SetupCategoryCamera();
+	Catalog.SetupCategoryProfiler();
+	Catalog.SetupCategoryDisplay();
+	Catalog.SetupCategoryShowDebug();
+	Catalog.SetupCategoryViewMode();
+	Catalog.SetupCategoryScalability();
+	Catalog.SetupCategoryFreeze();
+	Catalog.SetupCategoryDumpLogs();
+	Catalog.SetupCategoryNetwork();
+	Catalog.SetupCategorySound();
+	Catalog.SetupCategoryAbilitySystem();
+	Catalog.SetupCategoryOther();
+	Catalog.SetupCategoryLogVerbosity();
+	return Catalog;
+}
+
+void FGDMConsoleCommandCatalog::SetupCategoryResets()
 {
 	FGDMConsoleCommandSingle Single;
 	Single.CategoryIndex		= 0; /* Resets */
@@ -448,7 +530,7 @@ void UGameDebugMenuSettings::SetupCategoryResets()
 	ConsoleCommandPairs.Add(Pair);
 }
 
-void UGameDebugMenuSettings::SetupCategorySlomo()
+void FGDMConsoleCommandCatalog::SetupCategorySlomo()
 {
 	FGDMConsoleCommandSingle Single;
 	Single.CategoryIndex = 1; /* Slomo */
@@ -479,7 +561,7 @@ void UGameDebugMenuSettings::SetupCategorySlomo()
 	ConsoleCommandNumbers.Add(Number);
 }
 
-void UGameDebugMenuSettings::SetupCategoryCamera()
+void FGDMConsoleCommandCatalog::SetupCategoryCamera()
 {
 	FGDMConsoleCommandSingle Single;
 	Single.CategoryIndex = 2; /* Camera */
@@ -510,7 +592,7 @@ void UGameDebugMenuSettings::SetupCategoryCamera()
 	ConsoleCommandPairs.Add(Pair);
 }
 
-void UGameDebugMenuSettings::SetupCategoryProfiler()
+void FGDMConsoleCommandCatalog::SetupCategoryProfiler()
 {
 	FGDMConsoleCommandSingle Single;
 	Single.CategoryIndex = 3; /* Profiler */
@@ -594,7 +676,7 @@ void UGameDebugMenuSettings::SetupCategoryProfiler()
 	ConsoleCommandPairs.Add(Pair);
 }
 
-void UGameDebugMenuSettings::SetupCategoryDisplay()
+void FGDMConsoleCommandCatalog::SetupCategoryDisplay()
 {
 	FGDMConsoleCommandSingle Single;
 	Single.CategoryIndex = 4; /* Display */
@@ -739,7 +821,7 @@ void UGameDebugMenuSettings::SetupCategoryDisplay()
 	Group.ConsoleCommandNames.Empty();
 }
 
-void UGameDebugMenuSettings::SetupCategoryShowDebug()
+void FGDMConsoleCommandCatalog::SetupCategoryShowDebug()
 {
 	FGDMConsoleCommandPair Pair;
 	Pair.CategoryIndex = 5; /* Show Debug */
@@ -869,7 +951,7 @@ void UGameDebugMenuSettings::SetupCategoryShowDebug()
 
 }
 
-void UGameDebugMenuSettings::SetupCategoryViewMode()
+void FGDMConsoleCommandCatalog::SetupCategoryViewMode()
 {
 	FGDMConsoleCommandSingle Single;
 	Single.CategoryIndex = 6; /* ViewMode */
@@ -1129,7 +1211,7 @@ void UGameDebugMenuSettings::SetupCategoryViewMode()
 	/* EditorOnly */
 }
 
-void UGameDebugMenuSettings::SetupCategoryScalability()
+void FGDMConsoleCommandCatalog::SetupCategoryScalability()
 {
 	FGDMConsoleCommandNumber Number;
 	Number.CategoryIndex = 7; /* Scalability */
@@ -1324,7 +1406,7 @@ void UGameDebugMenuSettings::SetupCategoryScalability()
 	ConsoleCommandPairs.Add(Pair);
 }
 
-void UGameDebugMenuSettings::SetupCategoryFreeze()
+void FGDMConsoleCommandCatalog::SetupCategoryFreeze()
 {
 	FGDMConsoleCommandSingle Single;
 	Single.CategoryIndex = 8; /* Freeze */
@@ -1360,7 +1442,7 @@ void UGameDebugMenuSettings::SetupCategoryFreeze()
 
 }
 
-void UGameDebugMenuSettings::SetupCategoryDumpLogs()
+void FGDMConsoleCommandCatalog::SetupCategoryDumpLogs()
 {
 	FGDMConsoleCommandSingle Single;
 	Single.CategoryIndex = 9; /* Dump Logs */
@@ -1435,7 +1517,7 @@ void UGameDebugMenuSettings::SetupCategoryDumpLogs()
 	ConsoleCommandNumbers.Add(Number);
 }
 
-void UGameDebugMenuSettings::SetupCategoryNetwork()
+void FGDMConsoleCommandCatalog::SetupCategoryNetwork()
 {
 	FGDMConsoleCommandNumber Number;
 	Number.CategoryIndex = 10; /* Network */
@@ -1662,7 +1744,7 @@ void UGameDebugMenuSettings::SetupCategoryNetwork()
 	
 }
 
-void UGameDebugMenuSettings::SetupCategorySound()
+void FGDMConsoleCommandCatalog::SetupCategorySound()
 {
 	FGDMConsoleCommandSingle Single;
 	Single.CategoryIndex = 11; /* Sounds */
@@ -1685,7 +1767,7 @@ void UGameDebugMenuSettings::SetupCategorySound()
 	Group.ConsoleCommandNames.Empty();
 }
 
-void UGameDebugMenuSettings::SetupCategoryAbilitySystem()
+void FGDMConsoleCommandCatalog::SetupCategoryAbilitySystem()
 {
 	/* https://dev.epicgames.com/community/learning/tutorials/Y477/unreal-engine-gameplay-ability-system-debugging-tools */
 	
@@ -1760,7 +1842,7 @@ void UGameDebugMenuSettings::SetupCategoryAbilitySystem()
 	ConsoleCommandNumbers.Add(Number);
 }
 
-void UGameDebugMenuSettings::SetupCategoryOther()
+void FGDMConsoleCommandCatalog::SetupCategoryOther()
 {
 	FGDMConsoleCommandSingle Single;
 	Single.CategoryIndex = 13; /* Other */
@@ -1811,7 +1893,7 @@ void UGameDebugMenuSettings::SetupCategoryOther()
 
 }
 
-void UGameDebugMenuSettings::SetupCategoryLogVerbosity()
+void FGDMConsoleCommandCatalog::SetupCategoryLogVerbosity()
 {
 	/* Engine\Source\Runtime\Core\Public\Logging\LogVerbosity.hのELogVerbosity参照 */
 	FGDMConsoleCommandSingle Single;
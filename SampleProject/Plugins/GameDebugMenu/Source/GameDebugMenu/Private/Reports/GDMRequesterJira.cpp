@@ -180,7 +180,7 @@ void AGDMRequesterJira::RequestUploadContent(const FString& IssueKey)
 	if(bSendLogs)
 	{
 		FString GameLog;
-		GetOwnerDebugMenuManager()->GetOutputLogString(GameLog, LineBreak);
+		GetReportLogString(GameLog);
 		const FString DataName = FString::Printf(TEXT("name=\"file\";  filename=\"%s.txt\""), *UKismetSystemLibrary::GetGameName());
 		AddContentString(BoundaryKey, DataName, TEXT("text/plain; charset=UTF-8"), GameLog, ContentData);
 	}
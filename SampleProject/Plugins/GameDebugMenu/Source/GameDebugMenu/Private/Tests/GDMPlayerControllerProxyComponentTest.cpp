@@ -0,0 +1,154 @@
+/**
+* Copyright (c) 2020 akihiko moroi
+*
+* This software is released under the MIT License.
+* (See accompanying file LICENSE.txt or copy at http://opensource.org/licenses/MIT)
+*/
+
+#include "CoreMinimal.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/ScopeExit.h"
+
+#include "Component/GDMPlayerControllerProxyComponent.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+/**
+ * テストからUGDMPlayerControllerProxyComponentの送信前の処理を呼ぶためのアクセサ
+ */
+struct FGDMPlayerControllerProxyComponentTestAccess
+{
+	static void AddPendingServerAllCommand(UGDMPlayerControllerProxyComponent* Proxy, const FString& Command)
+	{
+		Proxy->AddPendingServerAllCommand(Command);
+	}
+
+	static const TArray<FString>& GetPendingServerAllCommands(const UGDMPlayerControllerProxyComponent* Proxy)
+	{
+		return Proxy->PendingServerAllCommands;
+	}
+
+	static void ResetPendingServerAllCommands(UGDMPlayerControllerProxyComponent* Proxy)
+	{
+		Proxy->PendingServerAllCommands.Reset();
+	}
+
+	static TArray<TArray<FString>> SplitIntoBatches(const TArray<FString>& Commands)
+	{
+		TArray<TArray<FString>> Batches;
+		UGDMPlayerControllerProxyComponent::ForEachConsoleCommandBatch(Commands, [&Batches](const TArray<FString>& Batch)
+		{
+			Batches.Add(Batch);
+		});
+		return Batches;
+	}
+};
+
+/**
+ * ServerAllのコマンドをRPCにまとめる処理の単体テスト（順序、連続した同一コマンドの集約、1回のRPCの上限での分割、Serverで受け付ける件数）
+ * 通信は行わないので、実際にクライアントから送られたRPCの回数は確認しない
+ * (例: UnrealEditor-Cmd Project.uproject -nullrhi -ExecCmds="Automation RunTests GameDebugMenu.Net.ServerAllBatchingHelpers;Quit")
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGDMServerAllBatchingHelpersTest, "GameDebugMenu.Net.ServerAllBatchingHelpers",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FGDMServerAllBatchingHelpersTest::RunTest(const FString& Parameters)
+{
+	UWorld* World = UWorld::CreateWorld(EWorldType::Game, false, TEXT("GDMProxyComponentTestWorld"));
+	FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+	WorldContext.SetCurrentWorld(World);
+
+	ON_SCOPE_EXIT
+	{
+		GEngine->DestroyWorldContext(World);
+		World->DestroyWorld(false);
+	};
+
+	APlayerController* PC = World->SpawnActor<APlayerController>();
+	if (!TestNotNull(TEXT("PlayerController"), PC))
+	{
+		return false;
+	}
+
+	/* Flushは呼ばない（スタンドアロンではRPCがローカル実行になりManagerが必要になる） */
+	UGDMPlayerControllerProxyComponent* Proxy = NewObject<UGDMPlayerControllerProxyComponent>(PC);
+	Proxy->RegisterComponent();
+
+	/* 順序と連続した同一コマンドの集約 */
+	{
+		const TCHAR* Commands[] = { TEXT("stat fps"), TEXT("stat fps"), TEXT("stat unit"), TEXT("stat fps"), TEXT("r.VSync 0"), TEXT("r.VSync 0") };
+		for (const TCHAR* Command : Commands)
+		{
+			FGDMPlayerControllerProxyComponentTestAccess::AddPendingServerAllCommand(Proxy, Command);
+		}
+		FGDMPlayerControllerProxyComponentTestAccess::AddPendingServerAllCommand(Proxy, FString());
+
+		const TArray<FString> Expected = { TEXT("stat fps"), TEXT("stat unit"), TEXT("stat fps"), TEXT("r.VSync 0") };
+		TestTrue(TEXT("Commands are kept in order with consecutive duplicates collapsed"),
+			FGDMPlayerControllerProxyComponentTestAccess::GetPendingServerAllCommands(Proxy) == Expected);
+		TestTrue(TEXT("Tick is enabled while commands are pending"), Proxy->IsComponentTickEnabled());
+
+		const TArray<TArray<FString>> Batches = FGDMPlayerControllerProxyComponentTestAccess::SplitIntoBatches(Expected);
+		if (TestEqual(TEXT("One batch under the cap"), Batches.Num(), 1))
+		{
+			TestTrue(TEXT("The batch is sent as is"), Batches[0] == Expected);
+		}
+
+		FGDMPlayerControllerProxyComponentTestAccess::ResetPendingServerAllCommands(Proxy);
+	}
+
+	/* 何もなければ送らない */
+	{
+		TestEqual(TEXT("Empty commands produce no batch"), FGDMPlayerControllerProxyComponentTestAccess::SplitIntoBatches(TArray<FString>()).Num(), 0);
+	}
+
+	/* 1回のRPCの上限を超えた分は分割して順番に送る */
+	{
+		const int32 Max = UGDMPlayerControllerProxyComponent::MaxBatchedConsoleCommands;
+		const int32 NumCommands = Max * 2 + 5;
+
+		TArray<FString> Commands;
+		for (int32 Index = 0; Index < NumCommands; ++Index)
+		{
+			Commands.Add(FString::Printf(TEXT("GDM.Test %d"), Index));
+		}
+
+		const TArray<TArray<FString>> Batches = FGDMPlayerControllerProxyComponentTestAccess::SplitIntoBatches(Commands);
+		if (TestEqual(TEXT("Split into capped batches"), Batches.Num(), 3))
+		{
+			TestEqual(TEXT("Batch 0 size"), Batches[0].Num(), Max);
+			TestEqual(TEXT("Batch 1 size"), Batches[1].Num(), Max);
+			TestEqual(TEXT("Batch 2 size"), Batches[2].Num(), 5);
+
+			int32 Expected = 0;
+			bool bInOrder = true;
+			for (const TArray<FString>& Batch : Batches)
+			{
+				for (const FString& Command : Batch)
+				{
+					bInOrder &= (Command == FString::Printf(TEXT("GDM.Test %d"), Expected++));
+				}
+			}
+			TestTrue(TEXT("Batches keep the original order"), bInOrder);
+		}
+	}
+
+	/* Serverで受け付ける件数 */
+	{
+		TArray<FString> Commands;
+		TestFalse(TEXT("Empty batch is rejected"), Proxy->ROS_ExecuteConsoleCommands_Validate(Commands, true));
+
+		Commands.Init(TEXT("stat fps"), UGDMPlayerControllerProxyComponent::MaxBatchedConsoleCommands);
+		TestTrue(TEXT("Batch at the cap is accepted"), Proxy->ROS_ExecuteConsoleCommands_Validate(Commands, true));
+
+		Commands.Add(TEXT("stat fps"));
+		TestFalse(TEXT("Batch over the cap is rejected"), Proxy->ROS_ExecuteConsoleCommands_Validate(Commands, true));
+	}
+
+	return true;
+}
+
+#endif
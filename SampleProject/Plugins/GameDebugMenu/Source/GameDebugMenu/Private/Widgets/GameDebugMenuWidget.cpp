@@ -19,6 +19,8 @@ UGameDebugMenuWidget::UGameDebugMenuWidget(const FObjectInitializer& ObjectIniti
 	, OnSendWidgetEventDispatcher()
 	, bActivateMenu(false)
 	, InputHandles()
+	, RegisteredManager(nullptr)
+	, RegisteredIndex(INDEX_NONE)
 {
 	/* UE5.7+: UUserWidgetはBPの入力ノード有無に応じてInputComponentを自動生成/登録し得る。
 	 * GameDebugMenuはUGDMInputSystemComponentでPush/Popを自前管理するため、自動登録は無効化しておく*/
@@ -27,6 +29,30 @@ UGameDebugMenuWidget::UGameDebugMenuWidget(const FObjectInitializer& ObjectIniti
 #endif
 }
 
+void UGameDebugMenuWidget::ReleaseSlateResources(bool bReleaseChildren)
+{
+	Super::ReleaseSlateResources(bReleaseChildren);
+
+	UnregisterFromDebugMenuManager();
+}
+
+void UGameDebugMenuWidget::BeginDestroy()
+{
+	UnregisterFromDebugMenuManager();
+
+	Super::BeginDestroy();
+}
+
+TSharedRef<SWidget> UGameDebugMenuWidget::RebuildWidget()
+{
+	/* 子供のWidgetが先に作られるので、登録順は子供が先になる */
+	TSharedRef<SWidget> Widget = Super::RebuildWidget();
+
+	RegisterToDebugMenuManager();
+
+	return Widget;
+}
+
 void UGameDebugMenuWidget::CreateInputComponent()
 {
 	/* 手動で生成するので何もしない */
@@ -140,15 +166,30 @@ void UGameDebugMenuWidget::SendSelfEvent(FName EventName)
 	OnSendWidgetEventDispatcher.Broadcast(this, EventName);
 }
 
-void UGameDebugMenuWidget::ExecuteGDMConsoleCommand(const FString Command, const EGDMConsoleCommandNetType CommandNetType)
+int32 UGameDebugMenuWidget::ExecuteGDMConsoleCommand(const FString Command, const EGDMConsoleCommandNetType CommandNetType)
 {
 	if (const APlayerController* PC = GetOriginalPlayerController() )
 	{
 		if( UGDMPlayerControllerProxyComponent* DebugMenuPCProxyComponent = PC->FindComponentByClass<UGDMPlayerControllerProxyComponent>() )
 		{
-			DebugMenuPCProxyComponent->ExecuteConsoleCommand(Command, CommandNetType);
+			return DebugMenuPCProxyComponent->ExecuteConsoleCommand(Command, CommandNetType);
 		}
 	}
+
+	return INDEX_NONE;
+}
+
+int32 UGameDebugMenuWidget::ExecuteGDMConsoleCommands(const TArray<FString>& Commands, const EGDMConsoleCommandNetType CommandNetType)
+{
+	if (const APlayerController* PC = GetOriginalPlayerController() )
+	{
+		if( UGDMPlayerControllerProxyComponent* DebugMenuPCProxyComponent = PC->FindComponentByClass<UGDMPlayerControllerProxyComponent>() )
+		{
+			return DebugMenuPCProxyComponent->ExecuteConsoleCommands(Commands, CommandNetType);
+		}
+	}
+
+	return INDEX_NONE;
 }
 
 bool UGameDebugMenuWidget::IsActivateDebugMenu()
@@ -193,29 +234,68 @@ bool UGameDebugMenuWidget::GetWidgetChildrenOfClass(TSubclassOf<UWidget> WidgetC
 {
 	OutChildWidgets.Reset();
 
+	ForEachChildWidget([&](UWidget* Widget)
+	{
+		if( Widget->GetClass()->IsChildOf(WidgetClass) )
+		{
+			OutChildWidgets.Add(Widget);
+
+			if( bEndSearchAsYouFind )
+			{
+				/* 一致したものがあればそのまま終了 */
+				return false;
+			}
+		}
+		return true;
+	});
+
+	return (OutChildWidgets.Num() > 0);
+}
+
+int32 UGameDebugMenuWidget::GetWidgetChildrenOfClasses(TConstArrayView<TSubclassOf<UWidget>> WidgetClasses, TArray<TArray<UWidget*>>& OutChildWidgets)
+{
+	OutChildWidgets.SetNum(WidgetClasses.Num(), EAllowShrinking::No);
+	for( TArray<UWidget*>& ChildWidgets : OutChildWidgets )
+	{
+		ChildWidgets.Reset();
+	}
+
+	int32 NumFound = 0;
+	ForEachChildWidget([&](UWidget* Widget)
+	{
+		const UClass* Class = Widget->GetClass();
+		for( int32 Index = 0; Index < WidgetClasses.Num(); ++Index )
+		{
+			if( Class->IsChildOf(WidgetClasses[Index]) )
+			{
+				OutChildWidgets[Index].Add(Widget);
+				++NumFound;
+			}
+		}
+		return true;
+	});
+
+	return NumFound;
+}
+
+void UGameDebugMenuWidget::ForEachChildWidget(TFunctionRef<bool(UWidget*)> Visitor)
+{
 	/* 現在チェックするWidget郡 */
-	TInlineComponentArray<UWidget*> WidgetsToCheck;
+	TArray<UWidget*, TInlineAllocator<64>> WidgetsToCheck;
 
-	/* チェック済みWidget郡 */
-	TInlineComponentArray<UWidget*> CheckedWidgets;
+	/* 見つけたWidget郡（同じWidgetを何度も見ないように） */
+	TSet<const UWidget*> FoundWidgets;
 
 	/* 作業用 */
 	TArray<UWidget*> WorkWidgets;
 
 	WidgetsToCheck.Push(this);
+	FoundWidgets.Add(this);
 
 	while( WidgetsToCheck.Num() > 0 )
 	{
 		UWidget* PossibleParent = WidgetsToCheck.Pop(EAllowShrinking::No);
 
-		if( CheckedWidgets.Contains(PossibleParent) )
-		{
-			/* チェック済み */
-			continue;
-		}
-
-		CheckedWidgets.Add(PossibleParent);
-
 		WorkWidgets.Reset();
 
 		if(const UUserWidget* UserWidget = Cast<UUserWidget>(PossibleParent) )
@@ -232,27 +312,50 @@ bool UGameDebugMenuWidget::GetWidgetChildrenOfClass(TSubclassOf<UWidget> WidgetC
 
 		for( UWidget* Widget : WorkWidgets )
 		{
-			if( CheckedWidgets.Contains(Widget) )
+			bool bAlreadyFound = false;
+			FoundWidgets.Add(Widget, &bAlreadyFound);
+			if( bAlreadyFound )
 			{
 				/* チェック済み */
 				continue;
 			}
 
-			if( Widget->GetClass()->IsChildOf(WidgetClass) )
+			if( !Visitor(Widget) )
 			{
-				OutChildWidgets.Add(Widget);
-
-				if( bEndSearchAsYouFind )
-				{
-					/* 一致したものがあればそのまま終了 */
-					return (OutChildWidgets.Num() > 0);
-				}
+				return;
 			}
 
 			WidgetsToCheck.Push(Widget);
 		}
 	}
+}
 
-	return (OutChildWidgets.Num() > 0);
+void UGameDebugMenuWidget::RegisterToDebugMenuManager()
+{
+	if( IsDesignTime() || RegisteredManager.IsValid() )
+	{
+		return;
+	}
+
+	UWorld* World = GetWorld();
+	if( !IsValid(World) || !World->IsGameWorld() )
+	{
+		return;
+	}
+
+	if( AGameDebugMenuManager* Manager = UGameDebugMenuFunctions::GetGameDebugMenuManager(World, false) )
+	{
+		Manager->RegisterDebugMenuWidget(this);
+	}
 }
 
+void UGameDebugMenuWidget::UnregisterFromDebugMenuManager()
+{
+	if( AGameDebugMenuManager* Manager = RegisteredManager.GetEvenIfUnreachable() )
+	{
+		Manager->UnregisterDebugMenuWidget(this);
+	}
+
+	RegisteredManager.Reset();
+	RegisteredIndex = INDEX_NONE;
+}
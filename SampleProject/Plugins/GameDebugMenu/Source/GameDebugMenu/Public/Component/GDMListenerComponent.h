@@ -25,6 +25,9 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE_FiveParams(FGDMOnChangePropertyRotatorDelegat
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FGDMOnInputSystemDelegate, UObject*, TargetInputObject);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FGDMOnInputSystemChangeInputObjectDelegate, UObject*, NewInputObject, UObject*, OldInputObject);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FGDMOnChangeDebugMenuLanguageDelegate, const FName&, NewLanguageKey, const FName&, OldLanguageKey);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FGDMOnExportOutputLogProgressDelegate, float, Progress);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FGDMOnExportedOutputLogDelegate, bool, bSuccess, const FString&, FilePath);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FGDMOnExecutedConsoleCommandsDelegate, int32, RequestId);
 
 /**
 * DebugMenuでのイベントを取得できるコンポーネント
@@ -106,6 +109,18 @@ public:
 	/** DebugMenuのセーブが削除した時に呼ばれるイベント */
 	UPROPERTY(BlueprintAssignable, Category = "GDM|Dispatcher")
 	FGDMGameDebugMenuListenerDelegate OnDeletedDebugMenuDispatcher;
+
+	/** ゲーム内ログの書き出し中に進捗（0～1）が更新されたとき呼ばれるイベント */
+	UPROPERTY(BlueprintAssignable, Category = "GDM|Dispatcher")
+	FGDMOnExportOutputLogProgressDelegate OnExportOutputLogProgressDispatcher;
+
+	/** ゲーム内ログの書き出しが終わったとき呼ばれるイベント */
+	UPROPERTY(BlueprintAssignable, Category = "GDM|Dispatcher")
+	FGDMOnExportedOutputLogDelegate OnExportedOutputLogDispatcher;
+
+	/** EnqueueConsoleCommandsで追加したコマンドが全て実行されたとき呼ばれるイベント */
+	UPROPERTY(BlueprintAssignable, Category = "GDM|Dispatcher")
+	FGDMOnExecutedConsoleCommandsDelegate OnExecutedConsoleCommandsDispatcher;
 	
 public:	
 	UGDMListenerComponent(const FObjectInitializer& ObjectInitializer = FObjectInitializer::Get());
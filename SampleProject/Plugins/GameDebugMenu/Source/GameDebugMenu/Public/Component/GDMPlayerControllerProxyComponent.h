@@ -22,15 +22,27 @@ class GAMEDEBUGMENU_API UGDMPlayerControllerProxyComponent : public UActorCompon
 {
 	GENERATED_BODY()
 
+#if WITH_DEV_AUTOMATION_TESTS
+	friend struct FGDMPlayerControllerProxyComponentTestAccess;
+#endif
+
 public:
 	UPROPERTY(Replicated)
 	TObjectPtr<AGameDebugMenuManager> DebugMenuManager = nullptr;
-	
+
+	/** 1回のRPCで送る（受け付ける）コマンド数の上限 */
+	static constexpr int32 MaxBatchedConsoleCommands = 1024;
+
+private:
+	/** このフレームでServerに送るコマンド（Tickで1回のRPCにまとめて送信） */
+	TArray<FString> PendingServerAllCommands;
+
 public:	
 	UGDMPlayerControllerProxyComponent();
 	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps ) const override;
 	virtual void BeginPlay() override;
 	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
 
 public:
 	UFUNCTION(BlueprintPure)
@@ -51,6 +63,42 @@ public:
 	UFUNCTION(Client, Reliable, WithValidation)
 	void ROC_ExecuteConsoleCommand(const FString& Command);
 
-	virtual void ExecuteConsoleCommand(const FString& Command, EGDMConsoleCommandNetType CommandNetType);
+	/** 複数コマンドを1回で送る版 */
+	UFUNCTION(Server, Reliable, WithValidation)
+	void ROS_ExecuteConsoleCommands(const TArray<FString>& Commands, bool bAllClient);
+
+	UFUNCTION(Client, Reliable, WithValidation)
+	void ROC_ExecuteConsoleCommands(const TArray<FString>& Commands);
+
+	/**
+	 * コンソールコマンドを実行する
+	 * ServerAllをクライアントから実行した場合はフレームの最後にまとめて送る（直前と同じコマンドはまとめられる。EGDMConsoleCommandNetType::ServerAll参照）
+	 * @return LocalOnlyの場合は完了通知のID、それ以外はINDEX_NONE
+	 */
+	virtual int32 ExecuteConsoleCommand(const FString& Command, EGDMConsoleCommandNetType CommandNetType);
+
+	/**
+	 * 複数のコンソールコマンドを順番に実行する（LocalOnlyはManagerのキューで複数フレームに分けて実行）
+	 * @return LocalOnlyの場合は完了通知のID、それ以外はINDEX_NONE
+	 */
+	virtual int32 ExecuteConsoleCommands(const TArray<FString>& Commands, EGDMConsoleCommandNetType CommandNetType);
 	virtual void AllExecuteConsoleCommand_Server(const FString& Command);
+	virtual void AllExecuteConsoleCommands_Server(const TArray<FString>& Commands);
+
+protected:
+	/**
+	 * Serverに送るコマンドを追加する（直前と同じコマンドは追加しない）
+	 * トグル系のコマンドを同じフレームで2回続けると1回になるので、打ち消し合う前提のグループには使わないこと
+	 */
+	void AddPendingServerAllCommand(const FString& Command);
+
+	/**
+	 * 溜まっているコマンドを1回のRPCで送る
+	 */
+	void FlushPendingServerAllCommands();
+
+	/**
+	 * CommandsをMaxBatchedConsoleCommands毎に分けて順番にSendに渡す（上限以内ならCommandsをそのまま渡す）
+	 */
+	static void ForEachConsoleCommandBatch(const TArray<FString>& Commands, TFunctionRef<void(const TArray<FString>&)> Send);
 };
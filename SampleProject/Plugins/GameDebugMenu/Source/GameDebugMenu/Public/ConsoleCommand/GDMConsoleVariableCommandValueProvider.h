@@ -11,14 +11,25 @@
 #include "GDMConsoleCommandValueProvider.h"
 #include "GDMConsoleVariableCommandValueProvider.generated.h"
 
+struct IConsoleVariable;
+
 /**
  * ConsoleManager用プロバイダー
+ * 一度解決したコンソール変数は保持し、値は毎回コンソール変数から読む
+ * （FAutoConsoleVariableRefはC++側の変数へ直接書かれると変更通知が来ないため値は保持しない）
  */
 UCLASS()
 class GAMEDEBUGMENU_API UGDMConsoleVariableCommandValueProvider : public UGDMConsoleCommandValueProvider
 {
 	GENERATED_BODY()
 
+private:
+	/** コマンド名 -> 解決済みのコンソール変数 */
+	mutable TMap<FString, IConsoleVariable*> CachedConsoleVariables;
+
 public:
 	virtual bool GetFloatValue_Implementation(const FString& CommandName, float& OutValue) const override;
+
+private:
+	IConsoleVariable* FindOrResolveConsoleVariable(const FString& CommandName) const;
 };
@@ -9,6 +9,7 @@
 
 #include "CoreMinimal.h"
 #include "GameDebugMenuTypes.h"
+#include "ConsoleCommand/GDMConsoleCommandSearchIndex.h"
 #include "Engine/DataAsset.h"
 #include "GDMConsoleCommandSetAsset.generated.h"
 
@@ -70,7 +71,7 @@ public:
 #endif
 
 	/**
-	 * INIファイルで設定されたコマンド郡をこのアセットにセットする
+	 * INIファイルで設定されたコマンド郡（未設定ならプラグイン既定のコマンド）をこのアセットにセットする
 	 */
 	UFUNCTION(CallInEditor, Category = "Editor")
 	void SetupCommandNames();
@@ -153,4 +154,38 @@ public:
 
 	UFUNCTION(BlueprintCallable, BlueprintPure=false)
 	bool FindConsoleCommandNumberById(const FString& CommandId, FGDMConsoleCommandNumber& Out) const;
+
+	/**
+	* タイトル、コマンド、カテゴリ、説明からコマンドを検索し、一致度の高い順に最大MaxResults件返す
+	* 前回の検索文字列に追加入力した場合は前回の結果から絞り込む
+	*/
+	UFUNCTION(BlueprintCallable, BlueprintPure=false)
+	void SearchConsoleCommands(const FString& Query, int32 MaxResults, TArray<FGDMConsoleCommandSearchResult>& OutResults) const;
+
+public:
+	virtual void PostLoad() override;
+#if WITH_EDITOR
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+	virtual void PostEditUndo() override;
+#endif
+
+private:
+	/** 識別子に対応するコマンドの位置（通常の配列の後ろにEditorOnlyの配列が続く並びでのIndex） */
+	struct FCommandIndexEntry
+	{
+		EGDMConsoleCommandType Type;
+		int32 ArrayIndex;
+	};
+
+	/** 識別子からコマンドを引くためのインデックス。BuildCommandIdentifierは文字列生成が重いので事前に１度だけ行う */
+	mutable TMap<FString, FCommandIndexEntry> CommandIdentifierIndex;
+	mutable bool bCommandIdentifierIndexDirty = true;
+
+	/** SearchConsoleCommands用。初回検索時に作成する */
+	mutable FGDMConsoleCommandSearchIndex SearchIndex;
+
+	/** コマンド配列を変更したら呼ぶ */
+	void MarkCommandIndexDirty();
+	void RebuildCommandIdentifierIndex() const;
+	const FCommandIndexEntry* FindCommandIndexEntry(const FString& CommandId, EGDMConsoleCommandType Type) const;
 };
@@ -14,13 +14,15 @@
 
 class UWidget;
 
+DECLARE_DYNAMIC_DELEGATE_OneParam(FGDMOnCreatedDebugMenuManager, bool, bSuccess);
+
 UCLASS()
 class GAMEDEBUGMENU_API UGameDebugMenuFunctions : public UBlueprintFunctionLibrary
 {
 	GENERATED_BODY()
 
-	static TArray<FGDMPendingObjectData> RegisterPendingProperties;
-	static TArray<FGDMPendingObjectData> RegisterPendingFunctions;
+	/** マネージャー生成前に登録されたオブジェクト情報（ワールド毎） */
+	static TMap<TWeakObjectPtr<const UWorld>, FGDMPendingObjectQueue> PendingObjectQueues;
 	static FDelegateHandle ActorSpawnedDelegateHandle;
 	static bool bDisableGameDebugMenu;
 	
@@ -40,6 +42,15 @@ public:
 	*/
 	UFUNCTION(BlueprintCallable, Category = "GDM|Functions", meta = (Keywords = "DebugMenu GDM"))
 	static bool TryCreateDebugMenuManager(APlayerController* PlayerController, FString DebugMenuManagerClassName);
+
+	/** 
+	* 生成（非同期ロード版）。マネージャークラスのロード完了後に生成してOnCompletedを呼ぶ
+	* @param PlayerController - メニューを操作するローカルのプレイヤーコントローラー
+	* @param DebugMenuManagerClassName - 生成するマネージャークラス名(BP_GDM_Manager)
+	* @param OnCompleted - 生成処理の完了時に呼ばれる。false: デバックメニューは使用できない
+	*/
+	UFUNCTION(BlueprintCallable, Category = "GDM|Functions", meta = (Keywords = "DebugMenu GDM"))
+	static void TryCreateDebugMenuManagerAsync(APlayerController* PlayerController, FString DebugMenuManagerClassName, FGDMOnCreatedDebugMenuManager OnCompleted);
 	
 	/**
 	* 削除
@@ -298,7 +309,11 @@ public:
 	static FGDMMenuCategoryKey Conv_ByteToGDMMenuCategoryKey(const uint8& Key);
 
 private:
+	static bool FindDebugMenuManagerClass(APlayerController* PlayerController, const FString& DebugMenuManagerClassName, TSoftClassPtr<AGameDebugMenuManager>& OutManagerClass);
+	static bool CreateDebugMenuManager(APlayerController* PlayerController, const FString& DebugMenuManagerClassName, UClass* DebugMenuManagerClass);
 	static void OnActorSpawnedClientWaitManager(AGameDebugMenuManager* SpawnDebugMenuManager);
+	static FGDMPendingObjectQueue* FindOrAddPendingObjectQueue(const UObject* TargetObject);
+	static void FlushPendingObjectQueue(const UWorld* World, AGameDebugMenuManager* DebugMenuManager);
 	static void OnActorSpawnedServer(AActor* SpawnActor);
 	static void ShowDebugConsoleCommand();
 	static void HideDebugConsoleCommand();
@@ -9,6 +9,7 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/Actor.h"
+#include "UObject/ObjectKey.h"
 
 #include "GameDebugMenuTypes.h"
 #include "GameDebugMenuManager.generated.h"
@@ -21,6 +22,7 @@ class UGDMSaveSystemComponent;
 class UGDMPropertyJsonSystemComponent;
 class UGDMListenerComponent;
 class UGameDebugMenuWidget;
+class UGDMTextBlock;
 class UGDMInputSystemComponent;
 class UGDMScreenshotRequesterComponent;
 class UGameDebugMenuManagerAsset;
@@ -68,8 +70,10 @@ protected:
 	FTimerHandle InitializeManagerHandle;
 	bool bInitializedManager = false;
 
-	/** BeginPlay時点でOwnerが未確定なことがあるため、ローカル判定ができるまで短時間リトライする */
-	FTimerHandle LocalBeginPlayRetryHandle;
+	/** LocalPlayerやBP側の準備待ちで初期化できなかった（Tickで再度初期化する） */
+	bool bPendingInitializeManager = false;
+
+	/** BeginPlay時点でOwnerが未確定なことがあるため、Ownerが確定した時点でローカル判定する */
 	bool bLocalBeginPlayInitialized = false;
 
 	/** デバックメニュー用UIアセット */
@@ -86,6 +90,9 @@ protected:
 	/** メニュー開く前のポーズ判定 */
 	bool bCachedGamePaused;
 
+	/** 最後にメニューを開いた時間（FPlatformTime::Seconds）。レポートに添付するログ範囲の基準 */
+	double ShowDebugMenuTime;
+
 	/** メニュー開く前のマウスカーソル判定 */
 	bool bCachedShowMouseCursor;
 
@@ -100,6 +107,9 @@ protected:
 
 	/** 登録済み関数群 */
 	TArray<TSharedPtr<FGDMObjectFunctionInfo>> ObjectFunctions;
+
+	/** まとめて登録中は1件ごとのソートを省く */
+	bool bDeferSortObjects;
 	
 	/** Viewport上に追加されてるメインWidget */
 	UPROPERTY(Transient)
@@ -109,13 +119,42 @@ protected:
 	UPROPERTY(Transient,BlueprintReadOnly, Category = "GDM")
 	TMap<FString, TObjectPtr<UGameDebugMenuWidget>> DebugMenuInstances;
 
+	/** DebugMenuInstancesの逆引き（Widget -> キー）。BPからDebugMenuInstancesへ直接追加されるため、件数が変わっていたり引けなかったりしたら作り直す */
+	TMap<TObjectKey<UGameDebugMenuWidget>, FString> DebugMenuInstanceKeys;
+
 	/** Viewport上に追加されてるメニューWidgetのインスタンス */
 	UPROPERTY(Transient)
 	TArray<TObjectPtr<UGameDebugMenuWidget>> ViewportDebugMenuWidgets;
 
+	/** 言語切り替え時に更新するTextBlock（UGDMTextBlock側が自身の位置を持ち、削除は末尾と入れ替える） */
+	TArray<TWeakObjectPtr<UGDMTextBlock>> RegisteredTextBlocks;
+
+	/** 言語切り替え時に通知するDebugMenuWidget（RegisteredTextBlocksと同じく削除は末尾と入れ替える） */
+	TArray<TWeakObjectPtr<UGameDebugMenuWidget>> RegisteredDebugMenuWidgets;
+
 	/** DebugMenuのログデバイス（レポート送信用） */
 	TSharedPtr<FGDMOutputDevice> OutputLog;
 
+	/** 複数フレームに分けて実行するコンソールコマンド */
+	struct FQueuedConsoleCommands
+	{
+		int32 RequestId = INDEX_NONE;
+		TArray<FString> Commands;
+		int32 NextIndex = 0;
+		TWeakObjectPtr<APlayerController> PlayerController;
+	};
+
+	/** 追加された順に先頭から実行する（実行済みの要素はConsoleCommandQueueHeadより前に残し、まとめて詰める） */
+	TArray<FQueuedConsoleCommands> ConsoleCommandQueue;
+	int32 ConsoleCommandQueueHead;
+	int32 LastConsoleCommandRequestId;
+	bool bProcessingConsoleCommandQueue;
+
+	/** ConsoleCommandFrameBudgetMsを同じフレーム内の複数回の実行で共有するための情報 */
+	uint64 ConsoleCommandBudgetFrame;
+	double ConsoleCommandBudgetEndTime;
+	bool bExecutedConsoleCommandInBudgetFrame;
+
 public:
 	AGameDebugMenuManager(const FObjectInitializer& ObjectInitializer);
 	
@@ -125,6 +164,8 @@ protected:
 public:
 	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 	virtual void Tick(float DeltaTime) override;
+	virtual void SetOwner(AActor* NewOwner) override;
+	virtual void OnRep_Owner() override;
 	
 public:
 	UFUNCTION(BlueprintPure)
@@ -155,6 +196,16 @@ public:
 	bool IsInitializedManager() const;
 
 protected:
+	/**
+	* Ownerがローカルのプレイヤーコントローラーなら初期化を開始する（BeginPlay、Owner確定時に呼ばれる）
+	*/
+	void TryLocalBeginPlayInitialize();
+
+	/**
+	* ワールドのBeginPlay完了後に初期化する
+	*/
+	void HandleWorldBeginPlay();
+
 	/**
 	* マネージャーの初期化
 	*/
@@ -195,6 +246,14 @@ protected:
 	void TryEnableGamePause();
 	void RestoreGamePause() const;
 
+	/**
+	* キューのコンソールコマンドを予算内で実行する（Tickから呼ばれる）
+	*/
+	void ProcessConsoleCommandQueue();
+
+	/** 実行待ちのキューの数 */
+	int32 GetNumQueuedConsoleCommands() const;
+
 	/**
 	* スクショ処理終了後呼ばれる
 	*/
@@ -207,6 +266,32 @@ public:
 	*/
 	virtual void ExecuteConsoleCommand(const FString& Command, APlayerController* PC);
 
+	/**
+	* 複数のコンソールコマンドを順番に実行する
+	* 1フレームの実行時間がConsoleCommandFrameBudgetMsを超えたら残りは次のフレームで実行し、
+	* 全て実行したらListenerComponentのOnExecutedConsoleCommandsDispatcherで通知する
+	*
+	* @return 完了通知で渡されるID
+	*/
+	UFUNCTION(BlueprintCallable, Category = "GDM")
+	virtual int32 EnqueueConsoleCommands(const TArray<FString>& Commands, APlayerController* PC);
+
+	/**
+	* コンソールコマンドを1つキューに追加する
+	* 実行待ちが無く予算内ならその場で実行して戻る。実行待ちがある場合や同じフレームで予算を使い切っている場合は
+	* 次のフレーム以降に実行されるので、結果を参照する場合はOnExecutedConsoleCommandsDispatcherで完了を待つこと
+	*
+	* @return 完了通知で渡されるID（その場で実行された場合は戻る前に通知済み）。コマンドが空ならINDEX_NONE
+	*/
+	UFUNCTION(BlueprintCallable, Category = "GDM")
+	virtual int32 EnqueueConsoleCommand(const FString& Command, APlayerController* PC);
+
+	/**
+	* True: 実行待ちのコンソールコマンドがある
+	*/
+	UFUNCTION(BlueprintPure, Category = "GDM")
+	bool HasQueuedConsoleCommands() const;
+
 	/**
 	* DebugMenuの表示する
 	*/
@@ -262,6 +347,30 @@ public:
 	*/
 	virtual void GetOutputLogString(FString& OutLog, const FString& Separator);
 
+	/** 
+	* 記録時間（FPlatformTime::Seconds）が指定範囲のゲーム内ログ取得
+	*/
+	virtual void GetOutputLogStringInTimeRange(FString& OutLog, const FString& Separator, double StartTime, double EndTime);
+
+	/** 
+	* 記録フレーム（GFrameCounter）が指定範囲のゲーム内ログ取得
+	*/
+	virtual void GetOutputLogStringInFrameRange(FString& OutLog, const FString& Separator, uint64 StartFrame, uint64 EndFrame);
+
+	/**
+	* ゲーム内ログをワーカースレッドでファイルに書き出す（SaveFilePath以下に出力）
+	* 進捗と完了はListenerComponentのOnExportOutputLogProgressDispatcher/OnExportedOutputLogDispatcherで通知
+	*
+	* @param bCompress true: gzip圧縮（.log.gz）で書き出す
+	*/
+	UFUNCTION(BlueprintCallable, Category = "GDM")
+	virtual void ExportOutputLogAsync(const FString& FileName, bool bCompress = true);
+
+	/**
+	* 最後にメニューを開いた時間（FPlatformTime::Seconds）
+	*/
+	double GetShowDebugMenuTime() const;
+
 	/** 
 	* ゲーム中実行したコンソールコマンドの履歴を取得
 	*/
@@ -273,6 +382,11 @@ public:
 	virtual EGDMPropertyType GetPropertyType(const FProperty* TargetProperty) const;
 	virtual bool RegisterObjectProperty(UObject* TargetObject, const FName PropertyName, const FGDMGameplayCategoryKey& CategoryKey, const FString& PropertySaveKey, const FText& DisplayPropertyName, const FText& Description, const FGDMPropertyUIConfigInfo& PropertyUIConfigInfo, const int32& DisplayPriority);
 	virtual bool RegisterObjectFunction(UObject* TargetObject, const FName FunctionName, const FGDMGameplayCategoryKey& CategoryKey, const FString& FunctionSaveKey, const FText& DisplayFunctionName, const FText& Description, const int32& DisplayPriority);
+
+	/**
+	* マネージャー生成前に登録されたプロパティと関数をまとめて登録する（ソートは最後に1回だけ行う）
+	*/
+	virtual void RegisterPendingObjects(const FGDMPendingObjectQueue& PendingQueue);
 	virtual UObject* GetObjectProperty(const int32 Index, FGDMGameplayCategoryKey& OutCategoryKey, FString& OutPropertySaveKey, FText& OutDisplayPropertyName, FText& OutDescription, FName& OutPropertyName, EGDMPropertyType& OutPropertyType, FString& OutEnumPathName, FGDMPropertyUIConfigInfo& OutPropertyUIConfigInfo);
 	virtual void RemoveObjectProperty(const int32 Index);
 	virtual UObject* GetObjectFunction(const int32 Index, FGDMGameplayCategoryKey& OutCategoryKey, FString& OutFunctionSaveKey, FText& OutDisplayFunctionName, FText& OutDescription, FName& OutFunctionName);
@@ -320,6 +434,14 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "GDM")
 	virtual void ChangeDebugMenuLanguage(FName LanguageKey, bool bForcedUpdate);
 
+	/** 言語切り替えの対象としてTextBlockを登録/解除する（UGDMTextBlockから呼ばれる） */
+	void RegisterDebugMenuTextBlock(UGDMTextBlock* TextBlock);
+	void UnregisterDebugMenuTextBlock(UGDMTextBlock* TextBlock);
+
+	/** 言語切り替えの通知先としてDebugMenuWidgetを登録/解除する（UGameDebugMenuWidgetから呼ばれる） */
+	void RegisterDebugMenuWidget(UGameDebugMenuWidget* DebugMenuWidget);
+	void UnregisterDebugMenuWidget(UGameDebugMenuWidget* DebugMenuWidget);
+
 	/**
 	 * Viewport上にあるすべてのGameDebugMenuWidgetを取得する
 	 */
@@ -334,9 +456,15 @@ public:
 	
 protected:
 	virtual void CallExecuteConsoleCommandDispatcher(const FString& Command);
+	virtual void CallExecutedConsoleCommandsDispatcher(int32 RequestId);
 	virtual void CallShowDispatcher();
 	virtual void CallHideDispatcher();
 
+	void SortObjectProperties();
+	void SortObjectFunctions();
+
+	void RebuildDebugMenuInstanceKeys();
+
 	UFUNCTION()
 	virtual void OnWidgetAdded(UWidget* AddWidget, ULocalPlayer* Player);
 	
@@ -359,5 +487,7 @@ public:
 	virtual void CallLoadedDebugMenuDispatcher();
 	virtual void CallSavedDebugMenuDispatcher();
 	virtual void CallDeletedDebugMenuDispatcher();
+	virtual void CallExportOutputLogProgressDispatcher(float Progress);
+	virtual void CallExportedOutputLogDispatcher(bool bSuccess, const FString& FilePath);
 	
 };
@@ -147,7 +147,11 @@ enum class EGDMConsoleCommandNetType : uint8
 	/** ローカルでのみ実行する */
 	LocalOnly,
 
-	/** Serverで全プレイヤーに実行させる */
+	/**
+	 * Serverで全プレイヤーに実行させる
+	 * クライアントからは単発のコマンドもフレームの最後にまとめて1回のRPCで送るので、実行はそのフレームの終わり以降になる
+	 * また同じフレームで連続した同じコマンドは1回にまとめるので、"stat fps"を2回続けるようなトグル目的のグループは1回分しか実行されない
+	 */
 	ServerAll,
 };
 
@@ -262,6 +266,28 @@ struct GAMEDEBUGMENU_API FGDMConsoleCommandNumber : public FGDMConsoleCommand
 	virtual FString BuildCommandIdentifier() const override;
 };
 
+/**
+* コンソールコマンド検索の結果
+*/
+USTRUCT(BlueprintType)
+struct GAMEDEBUGMENU_API FGDMConsoleCommandSearchResult
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly)
+	EGDMConsoleCommandType Type;
+
+	/** UGDMConsoleCommandSetAssetのGet*ByArrayIndexで使用するIndex */
+	UPROPERTY(BlueprintReadOnly)
+	int32 ArrayIndex;
+
+	/** 一致度（大きいほど上位） */
+	UPROPERTY(BlueprintReadOnly)
+	float Score;
+
+	FGDMConsoleCommandSearchResult();
+};
+
 /**
  *
  */
@@ -389,6 +415,15 @@ struct GAMEDEBUGMENU_API FGDMPendingObjectData
 	}
 };
 
+/**
+* マネージャー生成前に登録されたオブジェクト情報（ワールド単位）
+*/
+struct GAMEDEBUGMENU_API FGDMPendingObjectQueue
+{
+	TArray<FGDMPendingObjectData> Properties;
+	TArray<FGDMPendingObjectData> Functions;
+};
+
 /**
 * 
 */
@@ -11,6 +11,7 @@
 #include "EnhancedInputComponent.h"
 #include "GDMEnhancedInputComponent.generated.h"
 
+class AGameDebugMenuManager;
 
 /**
  * DebugMenu用のUIで入力判定を制御する専用のEnhancedInputComponent
@@ -26,4 +27,10 @@ public:
 	virtual bool CanProcessInputAction(const UInputAction* Action) const;
 	FEnhancedInputActionEventBinding& BindDebugMenuAction(const UInputAction* Action, ETriggerEvent TriggerEvent, UObject* Object, FName FunctionName);
 	FEnhancedInputActionEventBinding& BindDebugMenuAction(const UInputAction* Action, ETriggerEvent TriggerEvent, TFunction<void(const FInputActionInstance&)>&& Callback);
+
+private:
+	/** 入力イベント毎にManagerを検索しないようにキャッシュ。Managerの破棄で無効になり、次回参照時に再取得する */
+	AGameDebugMenuManager* GetCachedManager() const;
+
+	mutable TWeakObjectPtr<AGameDebugMenuManager> CachedManager;
 };
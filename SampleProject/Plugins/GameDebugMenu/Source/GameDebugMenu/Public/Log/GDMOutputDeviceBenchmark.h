@@ -0,0 +1,38 @@
+/**
+* Copyright (c) 2020 akihiko moroi
+*
+* This software is released under the MIT License.
+* (See accompanying file LICENSE.txt or copy at http://opensource.org/licenses/MIT)
+*/
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * FGDMOutputDeviceの1行あたりの取り込みコストを計測する
+ * オートメーションテスト「GameDebugMenu.Log.OutputDeviceBenchmark」で閾値と比較する（Tests/GDMOutputDeviceBenchmarkTest.cpp）
+ * 手元での確認用にコンソールコマンド「GDM.BenchmarkOutputDevice [スレッド数] [1スレッドあたりの行数]」からも実行できる
+ */
+struct GAMEDEBUGMENU_API FGDMOutputDeviceBenchmark
+{
+	struct FResult
+	{
+		int32 NumThreads = 0;
+		int32 NumLines = 0;
+		double TotalSeconds = 0.0;
+		double LinesPerSecond = 0.0;
+		double P50Microseconds = 0.0;
+		double P99Microseconds = 0.0;
+		double MaxMicroseconds = 0.0;
+		SIZE_T LogBufferBytes = 0;
+
+		/** 計測前（デバイス生成前）からの使用物理メモリの増加量。終了時点と計測中の最大 */
+		int64 UsedPhysicalDelta = 0;
+		int64 PeakUsedPhysicalDelta = 0;
+	};
+
+	static FResult Run(int32 NumThreads, int32 NumLinesPerThread);
+
+	static void RunConsoleCommand(const TArray<FString>& Args);
+};
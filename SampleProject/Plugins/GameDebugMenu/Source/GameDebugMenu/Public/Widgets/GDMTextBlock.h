@@ -11,6 +11,8 @@
 #include "Components/TextBlock.h"
 #include "GDMTextBlock.generated.h"
 
+class AGameDebugMenuManager;
+
 /**
  * 
  */
@@ -28,16 +30,35 @@ public:
 	FName PreviewLanguageKey;
 #endif
 
+private:
+	/** 言語切り替え用に登録しているマネージャーとRegisteredTextBlocks内の位置 */
+	TWeakObjectPtr<AGameDebugMenuManager> RegisteredManager;
+	int32 RegisteredIndex;
+
+	friend class AGameDebugMenuManager;
+
 public:
 	UGDMTextBlock(const FObjectInitializer& ObjectInitializer);
 
 public:
 	virtual void SynchronizeProperties() override;
 	virtual void SetText(FText InText) override;
+	virtual void ReleaseSlateResources(bool bReleaseChildren) override;
+	virtual void BeginDestroy() override;
+
+	/** 解決済みの文字列をそのままセットする（言語切り替え時にマネージャーから呼ばれる） */
+	void SetResolvedDebugMenuString(const FString& DebugMenuString);
 
 	UFUNCTION(BlueprintCallable, Category = "Appearance")
 	virtual void SetWrapTextAt(float InWrapTextAt);
 
+protected:
+	virtual TSharedRef<SWidget> RebuildWidget() override;
+
+private:
+	void RegisterToDebugMenuManager();
+	void UnregisterFromDebugMenuManager();
+
 public:
 #if WITH_EDITOR
 	virtual const FText GetPaletteCategory() override;
@@ -14,6 +14,7 @@
 
 class UInputAction;
 class UGDMEnhancedInputComponent;
+class AGameDebugMenuManager;
 
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FGDMWidgetDelegate, UGameDebugMenuWidget*, TargetWidget, FName, EventName);
 
@@ -37,10 +38,21 @@ protected:
 	bool bActivateMenu;
 	TArray<uint32> InputHandles;
 
+private:
+	/** 言語切り替え用に登録しているマネージャーとRegisteredDebugMenuWidgets内の位置 */
+	TWeakObjectPtr<AGameDebugMenuManager> RegisteredManager;
+	int32 RegisteredIndex;
+
+	friend class AGameDebugMenuManager;
+
 public:
 	UGameDebugMenuWidget(const FObjectInitializer& ObjectInitializer);
+
+	virtual void ReleaseSlateResources(bool bReleaseChildren) override;
+	virtual void BeginDestroy() override;
 	
 protected:
+	virtual TSharedRef<SWidget> RebuildWidget() override;
 	virtual void CreateInputComponent() override;
 	virtual void StartProcessingInputScriptDelegates() override;
 	virtual void StopProcessingInputScriptDelegates() override;
@@ -98,9 +110,18 @@ public:
 
 	/**
 	* コンソールコマンドを実行する
+	* マネージャーのキューを通すので、実行待ちがある場合や同じフレームで続けて呼んで予算を超えた場合は次のフレーム以降に順番に実行される
+	* @return LocalOnlyの場合はOnExecutedConsoleCommandsDispatcherで通知されるID（その場で実行された場合は戻る前に通知済み）、それ以外はINDEX_NONE
+	*/
+	UFUNCTION(BlueprintCallable, Category = "GDM|Command")
+	int32 ExecuteGDMConsoleCommand(const FString Command, const EGDMConsoleCommandNetType CommandNetType);
+
+	/**
+	* 複数のコンソールコマンドを順番に実行する（コマンドグループ用。LocalOnlyは複数フレームに分けて実行）
+	* @return LocalOnlyの場合はOnExecutedConsoleCommandsDispatcherで通知されるID、それ以外はINDEX_NONE
 	*/
 	UFUNCTION(BlueprintCallable, Category = "GDM|Command")
-	void ExecuteGDMConsoleCommand(const FString Command, const EGDMConsoleCommandNetType CommandNetType);
+	int32 ExecuteGDMConsoleCommands(const TArray<FString>& Commands, const EGDMConsoleCommandNetType CommandNetType);
 
 	/**
 	* UIを表示するときのイベント
@@ -175,4 +196,20 @@ public:
 	*/
 	UFUNCTION(BlueprintCallable, Category = "GDM", meta = (DeterminesOutputType = "WidgetClass", DynamicOutputParam = "OutChildWidgets"))
 	virtual bool GetWidgetChildrenOfClass(TSubclassOf<UWidget> WidgetClass, TArray<UWidget*>& OutChildWidgets, bool bEndSearchAsYouFind);
+
+	/**
+	* 複数クラスの子供Widgetを1回の走査でまとめて取得する
+	* @param WidgetClasses   - 対象のクラス
+	* @param OutChildWidgets - WidgetClassesと同じ並びで取得できたWidgetを格納（呼び出し側の配列を再利用するので確保済みの領域はそのまま使う）
+	* @return 取得できたWidgetの総数
+	*/
+	int32 GetWidgetChildrenOfClasses(TConstArrayView<TSubclassOf<UWidget>> WidgetClasses, TArray<TArray<UWidget*>>& OutChildWidgets);
+
+protected:
+	/** 子供Widgetを1つずつVisitorに渡す。Visitorがfalseを返したら終了 */
+	void ForEachChildWidget(TFunctionRef<bool(UWidget*)> Visitor);
+
+private:
+	void RegisterToDebugMenuManager();
+	void UnregisterFromDebugMenuManager();
 };
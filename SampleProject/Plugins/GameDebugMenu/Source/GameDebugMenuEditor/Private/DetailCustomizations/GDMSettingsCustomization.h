@@ -0,0 +1,23 @@
+/**
+* Copyright (c) 2020 akihiko moroi
+*
+* This software is released under the MIT License.
+* (See accompanying file LICENSE.txt or copy at http://opensource.org/licenses/MIT)
+*/
+#pragma once
+
+#include "IDetailCustomization.h"
+
+/**
+ * Project SettingsのUGameDebugMenuSettings
+ * 既定のコンソールコマンド一覧は起動時に作らないので、開いた時にINIで設定されていない配列へセットする
+ */
+class FGDMSettingsCustomization : public IDetailCustomization
+{
+public:
+	static TSharedRef<IDetailCustomization> MakeInstance();
+
+	/* Begin IDetailCustomization */
+	virtual void CustomizeDetails(IDetailLayoutBuilder& DetailBuilder) override;
+	/* End IDetailCustomization */
+};